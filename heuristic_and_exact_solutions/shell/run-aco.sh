@@ -0,0 +1,11 @@
+#!/bin/bash
+cd ..
+#echo  GLOG_log_dir=`pwd`/log
+export GLOG_log_dir=`pwd`/log
+#export OMP_NUM_THREADS=4
+./bin/wf_security_greedy.x --tasks_and_files `pwd`/input/tasks_and_files/CyberShake_30.xml.dag \
+  --cluster `pwd`/input/clouds/cluster.vcl \
+  --conflict_graph `pwd`/input/conflict_graph/CyberShake_30.xml.scg \
+  --algorithm aco
+cd shell
+
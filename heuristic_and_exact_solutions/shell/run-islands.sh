@@ -0,0 +1,11 @@
+#!/bin/bash
+cd ..
+#echo  GLOG_log_dir=`pwd`/log
+export GLOG_log_dir=`pwd`/log
+#export OMP_NUM_THREADS=4
+# With -DWF_SECURITY_WITH_MPI=ON, prefix with "mpirun -np 4" for one island per MPI process
+./bin/wf_security_greedy.x --tasks_and_files `pwd`/input/tasks_and_files/CyberShake_30.xml.dag \
+  --cluster `pwd`/input/clouds/cluster.vcl \
+  --conflict_graph `pwd`/input/conflict_graph/CyberShake_30.xml.scg \
+  --algorithm islands --number_of_islands 4 --island_engine ils
+cd shell
@@ -15,6 +15,11 @@
 
 #include <glog/logging.h>
 #include <gflags/gflags.h>
+
+#ifdef WF_SECURITY_MPI
+#include <mpi.h>
+#endif
+
 #include <exception>
 #include "src/solution/algorithm.h"
 
@@ -50,18 +55,235 @@ DEFINE_double(alpha_restrict_candidate_list,
               0.5,
               "The threshold parameter to truncate the candidate list");
 
+DEFINE_string(reactive_alphas,
+              "",
+              "Comma separated alphas of the reactive GRASP, e.g. 0.1,0.3,0.5; empty for a fixed "
+              "alpha_restrict_candidate_list");
+
+DEFINE_uint64(reactive_update_period,
+              10ul,
+              "Number of GRASP iterations between two updates of the reactive alpha probabilities");
+
+DEFINE_string(path_relinking,
+              "none",
+              "Path relinking between the GRASP elite solutions: none, post (all pairs after the "
+              "iterations) or interleaved (the best with each other every path_relinking_period)");
+
+DEFINE_uint64(path_relinking_period,
+              10ul,
+              "Number of GRASP iterations between two interleaved path relinking phases");
+
+DEFINE_uint64(elite_pool_size,
+              10ul,
+              "Maximum number of solutions of the GRASP elite pool");
+
 DEFINE_uint64(number_of_iteration,
               100ul,
               "Number of attempts to build the solution");
 
 DEFINE_uint64(number_of_allocation_experiments,
               4ul,
-              "Number of allocation experiments");
+              "Deprecated and ignored, kept for the scripts that pass it; the output files are "
+              "always allocated at their best storage");
+
+DEFINE_string(local_search,
+              "none",
+              "Variable Neighbourhood Descent applied to the constructed solutions: none, first "
+              "(first improvement) or best (best improvement)");
+
+DEFINE_bool(critical_path_moves,
+            false,
+            "Restrict the local search moves that may cut the makespan to the critical path; the "
+            "other moves are kept only if they lower the estimated cost and exposure. Only the "
+            "descents of the local search (--local_search) use it; the moves of sa, tabu and "
+            "memetic are not filtered");
+
+DEFINE_bool(locality_aware_placement,
+            false,
+            "Also score the storages of an output file by the expected reads of its consumers");
+
+DEFINE_bool(cluster_chains,
+            false,
+            "Schedule each single-predecessor/single-successor chain of tasks at a single VM");
+
+DEFINE_bool(dominance_pruning,
+            true,
+            "Skip the Virtual Machines dominated for the task when probing");
+
+DEFINE_uint64(beam_width,
+              4ul,
+              "Number of partial schedules kept by the beam search at each step");
+
+DEFINE_uint64(beam_expansion,
+              2ul,
+              "Number of best (task, VM) moves expanded from each partial schedule of the beam");
+
+DEFINE_uint64(number_of_threads,
+              1ul,
+              "Number of threads used by the parallel algorithms");
+
+DEFINE_uint64(ils_perturbation_strength,
+              2ul,
+              "Number of tasks or files reassigned by the ILS perturbation after a new best "
+              "solution");
+
+DEFINE_uint64(ils_max_perturbation_strength,
+              10ul,
+              "Maximum ILS perturbation strength, reached after iterations without a new best");
+
+DEFINE_double(ils_acceptance_threshold,
+              0.01,
+              "Relative distance to the best solution under which ILS accepts a new local optimum");
+
+DEFINE_string(sa_cooling,
+              "geometric",
+              "Cooling schedule of the simulated annealing: geometric or adaptive");
+
+DEFINE_double(sa_cooling_rate,
+              0.95,
+              "Factor applied to the simulated annealing temperature at each level");
+
+DEFINE_double(sa_initial_acceptance,
+              0.5,
+              "Probability of accepting an average worsening move at the initial temperature");
+
+DEFINE_uint64(sa_moves_per_temperature,
+              1000ul,
+              "Number of simulated annealing moves per temperature level");
+
+DEFINE_uint64(sa_max_moves,
+              1000000ul,
+              "Maximum number of simulated annealing moves");
+
+DEFINE_uint64(tabu_tenure,
+              10ul,
+              "Number of iterations during which a task or a file may not return where it was");
+
+DEFINE_uint64(tabu_candidate_list_size,
+              200ul,
+              "Number of random moves sampled and evaluated at each tabu search iteration");
+
+DEFINE_uint64(tabu_table_size,
+              65536ul,
+              "Number of slots, a power of two, of the hashed tabu memory");
+
+DEFINE_uint64(memetic_population_size,
+              30ul,
+              "Number of individuals of the memetic algorithm population; also used by nsga2");
+
+DEFINE_uint64(memetic_number_of_generations,
+              100ul,
+              "Number of generations of the memetic algorithm; also used by nsga2");
+
+DEFINE_double(memetic_mutation_rate,
+              0.2,
+              "Probability of mutating an offspring of the memetic algorithm; also used by nsga2");
+
+DEFINE_uint64(memetic_local_search_moves,
+              20ul,
+              "Number of random moves tried by the local search of each memetic offspring");
+
+DEFINE_uint64(aco_number_of_ants,
+              10ul,
+              "Number of ants of each ant colony generation");
+
+DEFINE_uint64(aco_number_of_generations,
+              50ul,
+              "Number of ant colony generations");
+
+DEFINE_double(aco_alpha,
+              1.0,
+              "Exponent of the pheromone trail in the ant colony choices");
+
+DEFINE_double(aco_beta,
+              2.0,
+              "Exponent of the heuristic desirability in the ant colony choices");
+
+DEFINE_double(aco_evaporation,
+              0.1,
+              "Fraction of the ant colony pheromone that evaporates at each generation");
+
+DEFINE_string(aco_checkpoint_file,
+              "",
+              "File where the ant colony pheromone is saved after each generation and resumed "
+              "from");
+
+DEFINE_uint64(pareto_archive_size,
+              100ul,
+              "Maximum number of non-dominated solutions kept by the NSGA-II archive; at least 3");
+
+DEFINE_string(pareto_front_file,
+              "",
+              "CSV file that receives the makespan, cost and security exposure of the NSGA-II "
+              "front");
+
+DEFINE_uint64(lns_min_destroy_size,
+              4ul,
+              "Number of tasks or files destroyed by the LNS after an improvement");
+
+DEFINE_uint64(lns_max_destroy_size,
+              40ul,
+              "Maximum LNS destroy size, reached after iterations without improvement");
+
+DEFINE_uint64(lns_update_period,
+              20ul,
+              "Number of LNS iterations between two updates of the destroy operator weights");
+
+DEFINE_double(lns_reaction_factor,
+              0.3,
+              "Weight of the last period in the update of the LNS destroy operator weights");
+
+DEFINE_uint64(number_of_islands,
+              4ul,
+              "Number of processes forked by the island model; under MPI, one island per process");
+
+DEFINE_string(island_engine,
+              "ils",
+              "Algorithm run by each island, e.g. greedy_randomized_constructive_heuristic or ils");
+
+DEFINE_uint64(island_epochs,
+              10ul,
+              "Number of runs of the engine of each island; the islands migrate between two runs");
+
+DEFINE_uint64(migration_size,
+              2ul,
+              "Number of best distinct solutions each island sends to the next one at a migration");
+
+DEFINE_string(alpha_grid,
+              "",
+              "Run the algorithm for each alpha triple: a step dividing one, or a file of triples");
+
+DEFINE_double(time_limit_seconds,
+              3600.0,
+              "Wall-clock time limit, in seconds, checked between the iterations of the "
+              "algorithms");
 
 DEFINE_string(cplex_output_file,
               "graph1.col",
               "Example of input-file name");
 
+/**
+ * Under MPI, each process is an island (see \c IslandModel) and only the rank zero reports.
+ *
+ * \retval  first  False in the MPI processes but the rank zero
+ */
+static bool IsFirstProcess() {
+#ifdef WF_SECURITY_MPI
+  int initialized = 0;
+  int rank = 0;
+
+  MPI_Initialized(&initialized);
+
+  if (initialized) {
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  }
+
+  return rank == 0;
+#else
+  return true;
+#endif
+}  // static bool IsFirstProcess()
+
 /**
  * The \c main() function reads the loads the desired input files, applies the required algorithms
  * and writes output data files.
@@ -74,6 +296,16 @@ int main(int argc, char **argv) {
   gflags::SetVersionString("0.0.1");
   gflags::ParseCommandLineFlags(&argc, &argv, true);
 
+  // The CPLEX callback reports the values of its incumbents, never a Solution to keep
+  if (!FLAGS_alpha_grid.empty() && FLAGS_algorithm == "cplex") {
+    LOG(FATAL) << "--alpha_grid is not supported by the cplex algorithm";
+  }
+
+  if (!gflags::GetCommandLineFlagInfoOrDie("number_of_allocation_experiments").is_default) {
+    LOG(WARNING) << "--number_of_allocation_experiments is deprecated and ignored; the output "
+        "files are always allocated at their best storage";
+  }
+
   DLOG(INFO) << "Starting ...";
 
   DLOG(INFO) << "Input File of the Tasks and Files: " << FLAGS_tasks_and_files;
@@ -84,8 +316,54 @@ int main(int argc, char **argv) {
   DLOG(INFO) << "Alpha Budget weight: " << FLAGS_alpha_budget;
   DLOG(INFO) << "Alpha Security weight: " << FLAGS_alpha_security;
   DLOG(INFO) << "Alpha Restrict Candidate List threshold: " << FLAGS_alpha_restrict_candidate_list;
+  DLOG(INFO) << "Reactive alphas: " << FLAGS_reactive_alphas;
+  DLOG(INFO) << "Reactive update period: " << FLAGS_reactive_update_period;
+  DLOG(INFO) << "Path relinking: " << FLAGS_path_relinking;
+  DLOG(INFO) << "Path relinking period: " << FLAGS_path_relinking_period;
+  DLOG(INFO) << "Elite pool size: " << FLAGS_elite_pool_size;
   DLOG(INFO) << "Number of iteration: " << FLAGS_number_of_iteration;
   DLOG(INFO) << "Number of allocation experiments: " << FLAGS_number_of_allocation_experiments;
+  DLOG(INFO) << "Local search: " << FLAGS_local_search;
+  DLOG(INFO) << "Critical path moves: " << FLAGS_critical_path_moves;
+  DLOG(INFO) << "Locality aware placement: " << FLAGS_locality_aware_placement;
+  DLOG(INFO) << "Cluster chains: " << FLAGS_cluster_chains;
+  DLOG(INFO) << "Dominance pruning: " << FLAGS_dominance_pruning;
+  DLOG(INFO) << "Beam width: " << FLAGS_beam_width;
+  DLOG(INFO) << "Beam expansion: " << FLAGS_beam_expansion;
+  DLOG(INFO) << "Number of threads: " << FLAGS_number_of_threads;
+  DLOG(INFO) << "ILS perturbation strength: " << FLAGS_ils_perturbation_strength;
+  DLOG(INFO) << "ILS maximum perturbation strength: " << FLAGS_ils_max_perturbation_strength;
+  DLOG(INFO) << "ILS acceptance threshold: " << FLAGS_ils_acceptance_threshold;
+  DLOG(INFO) << "SA cooling: " << FLAGS_sa_cooling;
+  DLOG(INFO) << "SA cooling rate: " << FLAGS_sa_cooling_rate;
+  DLOG(INFO) << "SA initial acceptance: " << FLAGS_sa_initial_acceptance;
+  DLOG(INFO) << "SA moves per temperature: " << FLAGS_sa_moves_per_temperature;
+  DLOG(INFO) << "SA maximum number of moves: " << FLAGS_sa_max_moves;
+  DLOG(INFO) << "Tabu tenure: " << FLAGS_tabu_tenure;
+  DLOG(INFO) << "Tabu candidate list size: " << FLAGS_tabu_candidate_list_size;
+  DLOG(INFO) << "Tabu table size: " << FLAGS_tabu_table_size;
+  DLOG(INFO) << "Memetic population size: " << FLAGS_memetic_population_size;
+  DLOG(INFO) << "Memetic number of generations: " << FLAGS_memetic_number_of_generations;
+  DLOG(INFO) << "Memetic mutation rate: " << FLAGS_memetic_mutation_rate;
+  DLOG(INFO) << "Memetic local search moves: " << FLAGS_memetic_local_search_moves;
+  DLOG(INFO) << "ACO number of ants: " << FLAGS_aco_number_of_ants;
+  DLOG(INFO) << "ACO number of generations: " << FLAGS_aco_number_of_generations;
+  DLOG(INFO) << "ACO alpha: " << FLAGS_aco_alpha;
+  DLOG(INFO) << "ACO beta: " << FLAGS_aco_beta;
+  DLOG(INFO) << "ACO evaporation: " << FLAGS_aco_evaporation;
+  DLOG(INFO) << "ACO checkpoint file: " << FLAGS_aco_checkpoint_file;
+  DLOG(INFO) << "Pareto archive size: " << FLAGS_pareto_archive_size;
+  DLOG(INFO) << "Pareto front file: " << FLAGS_pareto_front_file;
+  DLOG(INFO) << "Alpha grid: " << FLAGS_alpha_grid;
+  DLOG(INFO) << "LNS minimum destroy size: " << FLAGS_lns_min_destroy_size;
+  DLOG(INFO) << "LNS maximum destroy size: " << FLAGS_lns_max_destroy_size;
+  DLOG(INFO) << "LNS update period: " << FLAGS_lns_update_period;
+  DLOG(INFO) << "LNS reaction factor: " << FLAGS_lns_reaction_factor;
+  DLOG(INFO) << "Number of islands: " << FLAGS_number_of_islands;
+  DLOG(INFO) << "Island engine: " << FLAGS_island_engine;
+  DLOG(INFO) << "Island epochs: " << FLAGS_island_epochs;
+  DLOG(INFO) << "Migration size: " << FLAGS_migration_size;
+  DLOG(INFO) << "Time limit: " << FLAGS_time_limit_seconds << " seconds";
   DLOG(INFO) << "CPLEX output file: " << FLAGS_cplex_output_file;
   // google::FlushLogFiles(google::INFO);
 
@@ -99,7 +377,17 @@ int main(int argc, char **argv) {
                        FLAGS_alpha_security,
                        FLAGS_alpha_restrict_candidate_list);
   algorithm->CalculateMaximumSecurityAndPrivacyExposure();
-  algorithm->Run();
+
+  // The alpha grid prints only its CSV rows
+  if (FLAGS_alpha_grid.empty()) {
+    algorithm->Run();
+
+    if (IsFirstProcess()) {
+      algorithm->ReportProbeStatistics();
+    }
+  } else {
+    algorithm->RunAlphaGrid(FLAGS_alpha_grid);
+  }
 
   DLOG(INFO) << "... ending.";
   gflags::ShutDownCommandLineFlags();
@@ -38,6 +38,12 @@ class ConflictGraph {
   /// Redefine the size of the conflict graph
   void Redefine(const int size) {
     conflicts_.redefine(size, size, 0);
+    adjacency_.assign(static_cast<size_t>(size), std::vector<std::pair<size_t, int>>());
+  }
+
+  /// Return the files in conflict with the file with ID \c i, paired with the conflict values
+  const std::vector<std::pair<size_t, int>>& GetConflicts(size_t i) const {
+    return adjacency_[i];
   }
 
   /// Return the conflict value between the file with ID \c i and file with ID \c j
@@ -47,6 +53,16 @@ class ConflictGraph {
 
   /// Add a new conflict value between the file with ID \c i and file with ID \c j
   void AddConflict(const size_t i, const size_t j, const int value) {
+    if (conflicts_(i, j) == 0 && value != 0) {
+      adjacency_[i].push_back(std::make_pair(j, value));
+      if (i != j) {
+        adjacency_[j].push_back(std::make_pair(i, value));
+      }
+    } else {
+      UpdateAdjacency(i, j, value);
+      UpdateAdjacency(j, i, value);
+    }
+
     conflicts_(i, j) = value;
     conflicts_(j, i) = value;
 
@@ -56,9 +72,27 @@ class ConflictGraph {
   }
 
  private:
+  /// Replace, or remove when \c value is zero, the conflict of \c j in the adjacency list of \c i
+  void UpdateAdjacency(const size_t i, const size_t j, const int value) {
+    for (size_t k = 0ul; k < adjacency_[i].size(); ++k) {
+      if (adjacency_[i][k].first == j) {
+        if (value != 0) {
+          adjacency_[i][k].second = value;
+        } else {
+          adjacency_[i][k] = adjacency_[i].back();
+          adjacency_[i].pop_back();
+        }
+        return;
+      }
+    }
+  }
+
   /// The matrix containing all conflict values
   Matrix<int> conflicts_;
 
+  /// The non-zero conflicts of each file; the same values of \c conflicts_
+  std::vector<std::vector<std::pair<size_t, int>>> adjacency_;
+
   /// A positive integer that contain the sum of all soft conflict value
   size_t maximum_of_soft_constraints = 0ul;
 };  // end of class ConflictGraph
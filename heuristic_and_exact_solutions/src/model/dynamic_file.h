@@ -16,6 +16,7 @@
 #include <glog/logging.h>
 
 #include <string>
+#include <vector>
 
 #include "src/model/file.h"
 
@@ -38,6 +39,9 @@ class DynamicFile : public File {
   /// Getter for the parent output file index
   size_t get_parent_output_file_index() { return parent_output_file_index_; }
 
+  /// Getter for the tasks that read this file
+  const std::vector<Task*>& get_consumers() const { return consumers_; }
+
   /// Setter for the parent task
   void set_parent_task(Task* parent_task) { parent_task_ = parent_task; }
 
@@ -46,6 +50,9 @@ class DynamicFile : public File {
     parent_output_file_index_ = parent_output_file_index;
   }
 
+  /// Add a task that reads this file
+  void AddConsumer(Task* consumer) { consumers_.push_back(consumer); }
+
   /// Concatenator operator
   friend std::ostream& operator<<(std::ostream& os, const DynamicFile& a) {
     return a.write(os);
@@ -65,6 +72,9 @@ class DynamicFile : public File {
 
   /// The index position of this generated file
   size_t parent_output_file_index_ = std::numeric_limits<size_t>::max();
+
+  /// The tasks that read this file; the reverse of the input files of the tasks
+  std::vector<Task*> consumers_;
 };  // end of class DynamicFile
 
 #endif  // APPROXIMATIVE_SOLUTIONS_SRC_MODEL_DYNAMIC_FILE_H_
@@ -12,7 +12,9 @@
 
 #include "src/model/solution.h"
 
+#include <functional>
 #include <numeric>
+#include <queue>
 #include <unordered_map>
 #include <utility>
 
@@ -23,14 +25,21 @@
 #include "src/model/static_file.h"
 #include <gflags/gflags.h>
 
-DECLARE_uint64(number_of_allocation_experiments);
+DECLARE_bool(locality_aware_placement);
 
-std::random_device random_device;
-std::mt19937 random_generator(random_device());
+// The auxiliary variables are per thread, so solutions can be built in parallel
+thread_local std::mt19937 random_generator(std::random_device{}());
 
-double aux_start_time = 0.0;
-double aux_read_time = 0.0;
-double aux_runtime = 0.0;
+thread_local double aux_start_time = 0.0;
+thread_local double aux_read_time = 0.0;
+thread_local double aux_runtime = 0.0;
+
+// Conflicts of the file being allocated at each storage; see AllocateOneOutputFileGreedily()
+thread_local std::vector<bool> aux_hard_conflict;
+thread_local std::vector<double> aux_soft_conflict;
+
+// Last task replayed at each VM; see ComputeMakespan()
+thread_local std::vector<size_t> aux_last_task;
 // std::mt19937 random_generator(static_cast<size_t>(time(0)));
 // std::mt19937 random_generator(0ul);
 
@@ -39,12 +48,15 @@ Solution::Solution(Algorithm* algorithm)
     : algorithm_(algorithm),
       task_allocations_(algorithm->GetTaskSize(), std::numeric_limits<size_t>::max()),
       file_allocations_(algorithm->GetFileSize(), std::numeric_limits<size_t>::max()),
+      storage_file_count_(algorithm->GetStorageSize(), 0ul),
+      storage_free_space_(algorithm->get_storage_vet()),
       time_vector_(algorithm->GetTaskSize(), 0.0),
       execution_vm_queue_(algorithm->GetVirtualMachineSize(), 0.0),
       allocation_vm_queue_(algorithm->GetVirtualMachineSize(), 0.0),
       makespan_(0.0),
       cost_(0.0),
-      security_exposure_(0.0) {
+      security_exposure_(0.0),
+      start_predecessor_(algorithm->GetTaskSize(), std::numeric_limits<size_t>::max()) {
 }  // Solution::Solution(Algorithm* algorithm)
 
 /**
@@ -79,8 +91,6 @@ double Solution::ObjectiveFunction(bool check_storage, bool check_sequence) {
     LOG(FATAL) << "Ordering has a wrong number of elements";
   }
 
-  fill(time_vector_.begin(), time_vector_.end(), 0.0);
-  fill(execution_vm_queue_.begin(), execution_vm_queue_.end(), 0.0);
   // fill(start_time_vector_.begin(), start_time_vector_.end(), -1);
 
   // for (size_t i = 0ul; i < scheduler_.size(); ++i) {
@@ -92,35 +102,542 @@ double Solution::ObjectiveFunction(bool check_storage, bool check_sequence) {
   // }
 
   if (check_storage && !checkFiles()) {
-    std::cerr << "check file error" << std::endl;
-    throw;
+    LOG(FATAL) << "The allocated files exceed the capacity of a storage";
   }
 
   // scheduler_.clear();
   // storage_queue_.clear();
 
+  // 1. Calculates the security exposure; the makespan and the cost are computed by Evaluate()
+  security_exposure_ = ComputeSecurityExposure();
+
+  return Evaluate(check_sequence);
+}  // void Solution::ComputeFitness(bool check_storage, bool check_sequence) {
+
+/**
+ * Replay the \c ordering_ to compute the makespan, then the cost, and combine them with the
+ * current \c security_exposure_. The local searches keep the security exposure up to date with
+ * the deltas of their moves (see \c MoveTask() and \c MoveFile()), so only the two replays,
+ * linear in the number of tasks and files, are paid per move instead of the quadratic
+ * \c ComputeSecurityExposure().
+ *
+ * \param[in]  check_sequence   Wheter to check the sequence or not
+ * \retval     objective_value  The weighted normalized objective value
+ */
+double Solution::Evaluate(bool check_sequence) {
+  fill(time_vector_.begin(), time_vector_.end(), 0.0);
+  fill(execution_vm_queue_.begin(), execution_vm_queue_.end(), 0.0);
+
   // 1. Calculates the makespan
   makespan_ = ComputeMakespan(check_sequence);
 
   // 2. Calculates the cost
   cost_ = ComputeCost();
 
-  // 3. Calculates the security exposure
-  security_exposure_ = ComputeSecurityExposure();
-
   DLOG(INFO) << "makespan: " << makespan_;
   DLOG(INFO) << "cost: " << cost_;
   DLOG(INFO) << "security_exposure: " << security_exposure_;
 
+  RestoreEvaluation(makespan_, cost_);
+
+  DLOG(INFO) << "objective_value_: " << objective_value_;
+
+  return objective_value_;
+}  // double Solution::Evaluate(bool check_sequence)
+
+/**
+ * \param[in]  makespan  The makespan before the undone move
+ * \param[in]  cost      The cost before the undone move
+ */
+void Solution::RestoreEvaluation(double makespan, double cost) {
+  makespan_ = makespan;
+  cost_ = cost;
   objective_value_ = algorithm_->get_alpha_time() * (makespan_ / algorithm_->get_makespan_max())
                    + algorithm_->get_alpha_budget() * (cost_ / algorithm_->get_budget_max())
                    + algorithm_->get_alpha_security() * (security_exposure_
                        / algorithm_->get_maximum_security_and_privacy_exposure());
+}  // void Solution::RestoreEvaluation(double makespan, double cost)
 
-  DLOG(INFO) << "objective_value_: " << objective_value_;
+/**
+ * The execution order of the tasks, \c ordering_, is kept; only the task exposure changes
+ * incrementally.
+ *
+ * \param[in]  task_id          The task to be moved
+ * \param[in]  vm_id            The new Virtual Machine of the task
+ * \param[in]  evaluate         Whether to replay the makespan and the cost
+ * \retval     objective_value  The new objective value; the outdated one when not evaluated
+ */
+double Solution::MoveTask(size_t task_id, size_t vm_id, bool evaluate) {
+  Task* task = algorithm_->GetTaskPerId(task_id);
+
+  security_exposure_ -= ComputeTaskSecurityExposure(
+      task, algorithm_->GetVirtualMachinePerId(task_allocations_[task_id]));
+  task_allocations_[task_id] = vm_id;
+  security_exposure_ += ComputeTaskSecurityExposure(task,
+                                                    algorithm_->GetVirtualMachinePerId(vm_id));
+
+  return evaluate ? Evaluate() : objective_value_;
+}  // double Solution::MoveTask(size_t task_id, size_t vm_id, bool evaluate)
+
+/**
+ * The \c storage_id must have room for the file, must not be masked for it (see
+ * \c Algorithm::IsStorageAllowed()) and must not hold a file in hard conflict with it. The file
+ * \c ignored_file_id is not considered, neither its space nor its conflicts, which allows to
+ * check a swap of two files.
+ *
+ * \param[in]  file_id          The file to be moved
+ * \param[in]  storage_id       The candidate storage
+ * \param[in]  ignored_file_id  A file that leaves \c storage_id along with the move
+ * \retval     feasible         True if the move keeps the solution feasible
+ */
+bool Solution::CanMoveFile(size_t file_id, size_t storage_id, size_t ignored_file_id) const {
+  double free_space = storage_free_space_[storage_id];
+
+  if (!algorithm_->IsStorageAllowed(file_id, storage_id)) {
+    return false;
+  }
+
+  if (ignored_file_id != std::numeric_limits<size_t>::max()
+      && file_allocations_[ignored_file_id] == storage_id) {
+    free_space += algorithm_->GetFilePerId(ignored_file_id)->get_size_in_MB();
+  }
+
+  if (file_allocations_[file_id] != storage_id
+      && free_space < algorithm_->GetFilePerId(file_id)->get_size_in_MB()) {
+    return false;
+  }
+
+  for (const auto& conflict : algorithm_->get_conflict_graph().GetConflicts(file_id)) {
+    if (conflict.second < 0 && conflict.first != file_id && conflict.first != ignored_file_id
+        && file_allocations_[conflict.first] == storage_id) {
+      return false;
+    }
+  }
+
+  return true;
+}  // bool Solution::CanMoveFile(...) const
+
+/**
+ * The soft conflicts of the file are subtracted at its old storage and added at the new one; the
+ * feasibility is not checked, see \c CanMoveFile().
+ *
+ * \param[in]  file_id          The file to be moved
+ * \param[in]  storage_id       The new storage of the file
+ * \param[in]  evaluate         Whether to replay the makespan and the cost
+ * \retval     objective_value  The new objective value; the outdated one when not evaluated
+ */
+double Solution::MoveFile(size_t file_id, size_t storage_id, bool evaluate) {
+  size_t old_storage_id = file_allocations_[file_id];
+
+  for (const auto& conflict : algorithm_->get_conflict_graph().GetConflicts(file_id)) {
+    if (conflict.second > 0 && conflict.first != file_id) {
+      if (file_allocations_[conflict.first] == old_storage_id) {
+        security_exposure_ -= conflict.second;
+      } else if (file_allocations_[conflict.first] == storage_id) {
+        security_exposure_ += conflict.second;
+      }
+    }
+  }
+
+  AllocateFile(file_id, storage_id);
+
+  return evaluate ? Evaluate() : objective_value_;
+}  // double Solution::MoveFile(size_t file_id, size_t storage_id, bool evaluate)
+
+/**
+ * The encoding has one integer per task, its Virtual Machine, one per file, its storage, and one
+ * per position of the ordering.
+ *
+ * \param[in]  algorithm      The algorithm that holds the instance
+ * \retval     encoding_size  The number of 32-bit integers of the encoding
+ */
+size_t Solution::GetEncodingSize(const Algorithm* algorithm) {
+  return 2ul * algorithm->GetTaskSize() + algorithm->GetFileSize();
+}  // size_t Solution::GetEncodingSize(const Algorithm* algorithm)
+
+/**
+ * The encoding is the compact form in which the solutions travel between processes (see
+ * \c IslandModel); an unallocated task or file is written as the maximum 32-bit integer. The
+ * \c code must hold \c GetEncodingSize() integers.
+ *
+ * \param[out]  code  The encoding of the solution
+ */
+void Solution::Encode(uint32_t* code) const {
+  for (size_t vm_id : task_allocations_) {
+    *code++ = vm_id == std::numeric_limits<size_t>::max() ? std::numeric_limits<uint32_t>::max()
+                                                          : static_cast<uint32_t>(vm_id);
+  }
+
+  for (size_t storage_id : file_allocations_) {
+    *code++ = storage_id == std::numeric_limits<size_t>::max()
+        ? std::numeric_limits<uint32_t>::max() : static_cast<uint32_t>(storage_id);
+  }
+
+  for (size_t task_id : ordering_) {
+    *code++ = static_cast<uint32_t>(task_id);
+  }
+}  // void Solution::Encode(uint32_t* code) const
+
+/**
+ * Any previous content of the solution is replaced; the storage counters are rebuilt from the
+ * file allocations and the values are computed from scratch. The index of the incremental moves
+ * is dropped (see \c PrepareIncrementalEvaluation()).
+ *
+ * \param[in]  code             The encoding written by \c Encode() for the same instance
+ * \retval     objective_value  The objective value of the decoded solution
+ */
+double Solution::Decode(const uint32_t* code) {
+  size_t task_size = algorithm_->GetTaskSize();
+
+  task_allocations_.assign(task_size, std::numeric_limits<size_t>::max());
+  file_allocations_.assign(algorithm_->GetFileSize(), std::numeric_limits<size_t>::max());
+  storage_file_count_.assign(algorithm_->GetStorageSize(), 0ul);
+  storage_free_space_ = algorithm_->get_storage_vet();
+  ordering_.clear();
+  ordering_position_.clear();
+  vm_sequences_.clear();
+
+  for (size_t task_id = 0ul; task_id < task_size; ++task_id, ++code) {
+    if (*code != std::numeric_limits<uint32_t>::max()) {
+      task_allocations_[task_id] = *code;
+    }
+  }
+
+  for (size_t file_id = 0ul; file_id < file_allocations_.size(); ++file_id, ++code) {
+    if (*code != std::numeric_limits<uint32_t>::max()) {
+      AllocateFile(file_id, *code);
+    }
+  }
+
+  for (size_t i = 0ul; i < task_size; ++i, ++code) {
+    AddOrdering(*code);
+  }
+
+  return ObjectiveFunction(false, false);
+}  // double Solution::Decode(const uint32_t* code)
+
+/**
+ * The finish times, the VM queues and the cost of the replay are kept afterwards by the
+ * incremental moves. The index is invalidated by \c MoveTask() and \c MoveFile(), which do not
+ * maintain it; call this method again after them.
+ *
+ * \retval  objective_value  The objective value of the replay
+ */
+double Solution::PrepareIncrementalEvaluation() {
+  ordering_position_.assign(algorithm_->GetTaskSize(), 0ul);
+  vm_sequences_.assign(algorithm_->GetVirtualMachineSize(), std::vector<size_t>());
+
+  for (size_t i = 0ul; i < ordering_.size(); ++i) {
+    size_t task_id = ordering_[i];
+
+    ordering_position_[task_id] = i;
+
+    if (task_id != algorithm_->get_id_source() && task_id != algorithm_->get_id_target()) {
+      vm_sequences_[task_allocations_[task_id]].push_back(task_id);
+    }
+  }
+
+  return Evaluate();
+}  // double Solution::PrepareIncrementalEvaluation()
+
+/**
+ * The task leaves the sequence of its VM and enters the sequence of \c vm_id at its position in
+ * \c ordering_. The task and its next tasks on both VMs are recomputed; the recomputation goes on
+ * only along the finish times that change (see \c PropagateFinishTimes()). The source and the
+ * target tasks are in no sequence and take no time, so only their exposure changes.
+ *
+ * \param[in]  task_id          The task to be moved
+ * \param[in]  vm_id            The new Virtual Machine of the task
+ * \retval     objective_value  The new objective value
+ */
+double Solution::MoveTaskIncrementally(size_t task_id, size_t vm_id) {
+  if (task_id == algorithm_->get_id_source() || task_id == algorithm_->get_id_target()) {
+    MoveTask(task_id, vm_id, false);
+    RestoreEvaluation(makespan_, cost_);
+    return objective_value_;
+  }
+
+  size_t old_vm_id = task_allocations_[task_id];
+  std::vector<size_t> tasks = {task_id};
+  std::vector<size_t> vms = {old_vm_id, vm_id};
+  auto by_position = [this](size_t a, size_t b) {
+    return ordering_position_[a] < ordering_position_[b];
+  };
+
+  std::vector<size_t>& old_sequence = vm_sequences_[old_vm_id];
+  auto old_position = std::lower_bound(old_sequence.begin(), old_sequence.end(), task_id,
+                                       by_position);
+
+  old_position = old_sequence.erase(old_position);
+
+  if (old_position != old_sequence.end()) {
+    tasks.push_back(*old_position);
+  }
+
+  std::vector<size_t>& new_sequence = vm_sequences_[vm_id];
+  auto new_position = std::lower_bound(new_sequence.begin(), new_sequence.end(), task_id,
+                                       by_position);
+
+  new_position = new_sequence.insert(new_position, task_id);
+
+  if (++new_position != new_sequence.end()) {
+    tasks.push_back(*new_position);
+  }
+
+  MoveTask(task_id, vm_id, false);
+
+  return PropagateFinishTimes(tasks, vms);
+}  // double Solution::MoveTaskIncrementally(size_t task_id, size_t vm_id)
+
+/**
+ * Only the producer, whose write time changes, and the consumers, whose read times change, are
+ * recomputed, along with the finish times that change after them. The bucket cost of the file is
+ * moved from the old storage to the new one.
+ *
+ * \param[in]  file_id          The dynamic file to be moved
+ * \param[in]  storage_id       The new storage of the file
+ * \retval     objective_value  The new objective value
+ */
+double Solution::MoveFileIncrementally(size_t file_id, size_t storage_id) {
+  DynamicFile* file = dynamic_cast<DynamicFile*>(algorithm_->GetFilePerId(file_id));
+  Storage* old_storage = algorithm_->GetStoragePerId(file_allocations_[file_id]);
+  Storage* new_storage = algorithm_->GetStoragePerId(storage_id);
+  std::vector<size_t> tasks = {file->get_parent_task()->get_id()};
+  std::vector<size_t> vms;
+
+  if (old_storage->get_id() >= algorithm_->GetVirtualMachineSize()) {
+    cost_ -= old_storage->get_cost() * file->get_size_in_GB();
+  }
+
+  if (new_storage->get_id() >= algorithm_->GetVirtualMachineSize()) {
+    cost_ += new_storage->get_cost() * file->get_size_in_GB();
+  }
+
+  for (Task* consumer : file->get_consumers()) {
+    tasks.push_back(consumer->get_id());
+  }
+
+  MoveFile(file_id, storage_id, false);
+
+  return PropagateFinishTimes(tasks, vms);
+}  // double Solution::MoveFileIncrementally(size_t file_id, size_t storage_id)
+
+/**
+ * A VM is billed until the finish time of its last task, from 0 (see \c PropagateFinishTimes()).
+ * Only the two queues change: the old VM ends earlier if the task was its last one, and the new VM
+ * ends later by the duration of the task if it goes in the middle of the queue, or from the later
+ * of its ready time and the end of the queue otherwise. The shifts of the other tasks, and so the
+ * makespan, are ignored. The \c Solution must be indexed by \c PrepareIncrementalEvaluation().
+ *
+ * \param[in]  task_id  The task to be moved
+ * \param[in]  vm_id    The candidate VM of the task
+ * \retval     delta    The estimated change of the cost of the VMs
+ */
+double Solution::EstimateTaskMoveCost(size_t task_id, size_t vm_id) const {
+  size_t old_vm_id = task_allocations_[task_id];
+  VirtualMachine* old_vm = algorithm_->GetVirtualMachinePerId(old_vm_id);
+  VirtualMachine* new_vm = algorithm_->GetVirtualMachinePerId(vm_id);
+  const std::vector<size_t>& old_sequence = vm_sequences_[old_vm_id];
+  const std::vector<size_t>& new_sequence = vm_sequences_[vm_id];
+  double duration = ComputeTaskDuration(algorithm_->GetTaskPerId(task_id), new_vm);
+  double delta = 0.0;
+
+  if (!old_sequence.empty() && old_sequence.back() == task_id) {
+    double end = old_sequence.size() > 1ul ? time_vector_[old_sequence[old_sequence.size() - 2ul]]
+                                           : 0.0;
+
+    delta += (end - execution_vm_queue_[old_vm_id]) * old_vm->get_cost();
+  }
+
+  if (new_sequence.empty()
+      || ordering_position_[new_sequence.back()] < ordering_position_[task_id]) {
+    double ready_time = 0.0;
+
+    for (size_t predecessor_id : algorithm_->GetPredecessors(task_id)) {
+      ready_time = std::max(ready_time, time_vector_[predecessor_id]);
+    }
+
+    delta += (std::max(ready_time, execution_vm_queue_[vm_id]) + duration
+              - execution_vm_queue_[vm_id]) * new_vm->get_cost();
+  } else {
+    delta += duration * new_vm->get_cost();
+  }
+
+  return delta;
+}  // double Solution::EstimateTaskMoveCost(size_t task_id, size_t vm_id) const
+
+/**
+ * The same times as \c ComputeMakespan(), but the reads do not touch \c cost_ nor
+ * \c allocation_vm_queue_.
+ *
+ * \param[in]  task             The task
+ * \param[in]  virtual_machine  The VM that executes the \c task
+ * \retval     duration         The read, run and write time of the \c task
+ */
+double Solution::ComputeTaskDuration(Task* task, VirtualMachine* virtual_machine) const {
+  double read_time = 0.0;
+
+  for (File* file : task->get_input_files()) {
+    size_t storage_id;
+
+    if (StaticFile* static_file = dynamic_cast<StaticFile*>(file)) {
+      storage_id = static_file->GetFirstVm();
+    } else {
+      storage_id = file_allocations_[file->get_id()];
+    }
+
+    read_time += ComputeFileTransferTime(file, algorithm_->GetStoragePerId(storage_id),
+                                         virtual_machine);
+  }
+
+  return read_time + task->get_time() * virtual_machine->get_slowdown()
+      + ComputeTaskWriteTime(task, virtual_machine);
+}  // double Solution::ComputeTaskDuration(Task* task, VirtualMachine* virtual_machine)
+
+/**
+ * Walk back from the target along \c start_predecessor_; each task of the path starts when the
+ * previous one finishes, so delaying any of them delays the makespan. Valid after \c Evaluate(),
+ * \c ObjectiveFunction() or an incremental move; a move undone by \c RestoreEvaluation() leaves
+ * it outdated.
+ *
+ * \retval     path  The tasks of the critical path, without the source and the target
+ */
+std::vector<size_t> Solution::GetCriticalPath() const {
+  std::vector<size_t> path;
+  size_t task_id = start_predecessor_[algorithm_->get_id_target()];
+
+  while (task_id != std::numeric_limits<size_t>::max() && task_id != algorithm_->get_id_source()) {
+    path.push_back(task_id);
+    task_id = start_predecessor_[task_id];
+  }
+
+  std::reverse(path.begin(), path.end());
+
+  return path;
+}  // std::vector<size_t> Solution::GetCriticalPath() const
+
+/**
+ * The workflow predecessor that finishes last wins, the first one on ties; the previous task on
+ * the VM wins only if it finishes strictly later.
+ *
+ * \param[in]  task_id           The task whose start time was computed
+ * \param[in]  previous_task_id  The previous task on its VM; \c max() if none
+ */
+void Solution::RecordStartPredecessor(size_t task_id, size_t previous_task_id) {
+  size_t start_predecessor = std::numeric_limits<size_t>::max();
+  double start_time = 0.0;
+
+  for (size_t predecessor_id : algorithm_->GetPredecessors(task_id)) {
+    if (start_predecessor == std::numeric_limits<size_t>::max()
+        || time_vector_[predecessor_id] > start_time) {
+      start_predecessor = predecessor_id;
+      start_time = time_vector_[predecessor_id];
+    }
+  }
+
+  if (previous_task_id != std::numeric_limits<size_t>::max()
+      && (start_predecessor == std::numeric_limits<size_t>::max()
+          || time_vector_[previous_task_id] > start_time)) {
+    start_predecessor = previous_task_id;
+  }
+
+  start_predecessor_[task_id] = start_predecessor;
+}  // void Solution::RecordStartPredecessor(size_t task_id, size_t previous_task_id)
+
+/**
+ * The tasks are recomputed in the order of \c ordering_, so the predecessors of a task, in the
+ * workflow and on its VM, are final when it is recomputed. A task whose finish time does not change
+ * stops the propagation; otherwise its successors and its next task on the VM are recomputed too.
+ * The cost of a VM changes with the finish time of its last task.
+ *
+ * \param[in]  tasks            The tasks whose times, or whose previous task on the VM, changed
+ * \param[in]  vms              The VMs whose sequence of tasks changed
+ * \retval     objective_value  The new objective value
+ */
+double Solution::PropagateFinishTimes(const std::vector<size_t>& tasks, std::vector<size_t>& vms) {
+  typedef std::pair<size_t, size_t> Entry;  // Position in ordering_ and task
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  size_t last_position = std::numeric_limits<size_t>::max();
+  auto by_position = [this](size_t a, size_t b) {
+    return ordering_position_[a] < ordering_position_[b];
+  };
+
+  for (size_t task_id : tasks) {
+    queue.emplace(ordering_position_[task_id], task_id);
+  }
+
+  while (!queue.empty()) {
+    Entry entry = queue.top();
+
+    queue.pop();
+
+    if (entry.first == last_position) {
+      continue;  // Already recomputed
+    }
+
+    last_position = entry.first;
+
+    size_t task_id = entry.second;
+    double finish_time = 0.0;
+
+    for (size_t predecessor_id : algorithm_->GetPredecessors(task_id)) {
+      finish_time = std::max(finish_time, time_vector_[predecessor_id]);
+    }
+
+    std::vector<size_t>* sequence = nullptr;
+    std::vector<size_t>::iterator position;
+    size_t previous_task_id = std::numeric_limits<size_t>::max();
+
+    if (task_id != algorithm_->get_id_target()) {
+      size_t vm_id = task_allocations_[task_id];
+
+      sequence = &vm_sequences_[vm_id];
+      position = std::lower_bound(sequence->begin(), sequence->end(), task_id, by_position);
+
+      if (position != sequence->begin()) {
+        previous_task_id = *(position - 1);
+        finish_time = std::max(finish_time, time_vector_[previous_task_id]);
+      }
+
+      finish_time += ComputeTaskDuration(algorithm_->GetTaskPerId(task_id),
+                                         algorithm_->GetVirtualMachinePerId(vm_id));
+    }
+
+    // The predecessor may change even if the finish time does not
+    RecordStartPredecessor(task_id, previous_task_id);
+
+    if (finish_time == time_vector_[task_id]) {
+      continue;
+    }
+
+    time_vector_[task_id] = finish_time;
+
+    for (size_t successor_id : algorithm_->GetSuccessors(task_id)) {
+      queue.emplace(ordering_position_[successor_id], successor_id);
+    }
+
+    if (sequence != nullptr) {
+      if (++position != sequence->end()) {
+        queue.emplace(ordering_position_[*position], *position);
+      } else {
+        vms.push_back(task_allocations_[task_id]);
+      }
+    }
+  }
+
+  for (size_t vm_id : vms) {
+    double finish_time = vm_sequences_[vm_id].empty() ? 0.0
+                                                      : time_vector_[vm_sequences_[vm_id].back()];
+
+    cost_ += (finish_time - execution_vm_queue_[vm_id])
+        * algorithm_->GetVirtualMachinePerId(vm_id)->get_cost();
+    execution_vm_queue_[vm_id] = finish_time;
+  }
+
+  RestoreEvaluation(time_vector_[algorithm_->get_id_target()], cost_);
 
   return objective_value_;
-}  // void Solution::ComputeFitness(bool check_storage, bool check_sequence) {
+}  // double Solution::PropagateFinishTimes(...)
 
 /**
  * Time necessary to write all output files of the \c task executed in the \c virtual_machine
@@ -129,7 +646,7 @@ double Solution::ObjectiveFunction(bool check_storage, bool check_sequence) {
  * \param[in]  virtual_machine  Virtual machine where the \c task will be executed
  * \retval     write_time       The accumulated time to write all output files of the \c task
  */
-double Solution::ComputeTaskWriteTime(Task* task, VirtualMachine* virtual_machine) {
+double Solution::ComputeTaskWriteTime(Task* task, VirtualMachine* virtual_machine) const {
   // Compute the write time
   double write_time = 0;
 
@@ -181,7 +698,7 @@ double Solution::ComputeTaskWriteTime(Task* task, VirtualMachine* virtual_machin
 double Solution::ComputeFileTransferTime(File* file,
                                          Storage* storage1,
                                          Storage* storage2,
-                                         bool check_constraints) {
+                                         bool check_constraints) const {
   double time = std::numeric_limits<double>::max();
 
   DLOG(INFO) << "Compute the transfer time of File[" << file->get_id() << "] to/from VM["
@@ -189,19 +706,13 @@ double Solution::ComputeFileTransferTime(File* file,
       << check_constraints << "]";
 
   if (check_constraints) {
-    for (size_t i = 0ul; i < algorithm_->GetFileSize(); ++i) {
-      size_t storage_id = file_allocations_[i];
-
-      // If file 'i' is to be transfered to the same place that file->get_id()
-      if (storage_id == storage2->get_id()) {
-        int conflict_value = algorithm_->get_conflict_graph().ReturnConflict(i, file->get_id());
-
-        if (conflict_value < 0) {
-          // Hard constraint; just return with std::numeric_limits<double>::max();
-          return time;
-        }
-      }  // else; allocated file resides in different storage or was not allocated yet
-    }  // for (...) {
+    for (const auto& conflict : algorithm_->get_conflict_graph().GetConflicts(file->get_id())) {
+      // If the file in conflict is to be transfered to the same place that file->get_id()
+      if (conflict.second < 0 && file_allocations_[conflict.first] == storage2->get_id()) {
+        // Hard constraint; just return with std::numeric_limits<double>::max();
+        return time;
+      }
+    }
   }  // if (check_constraints) {
 
   // If there is no Hard constraints; calculates de transfer time between storages
@@ -224,6 +735,8 @@ double Solution::ComputeFileTransferTime(File* file,
 double Solution::ComputeMakespan(bool check_sequence) {
   double makespan = 0.0;
 
+  aux_last_task.assign(algorithm_->GetVirtualMachineSize(), std::numeric_limits<size_t>::max());
+
   // compute makespan
   // for (auto id_task : ordering_) {  // For each task, do
   for (size_t i = 0ul; i < ordering_.size(); ++i) {
@@ -286,9 +799,12 @@ double Solution::ComputeMakespan(bool check_sequence) {
       time_vector_[id_task] = finish_time;
       // start_time_vector_[id_task] = start_time;
       execution_vm_queue_[vm->get_id()] = finish_time;
+      RecordStartPredecessor(id_task, aux_last_task[vm->get_id()]);
+      aux_last_task[vm->get_id()] = id_task;
     } else {  // Source and Target tasks
       if (id_task == algorithm_->get_id_source()) {  // Source task
         time_vector_[id_task] = 0;
+        start_predecessor_[id_task] = std::numeric_limits<size_t>::max();
       } else {  // Target task
         double max_value = 0.0;
 
@@ -298,6 +814,7 @@ double Solution::ComputeMakespan(bool check_sequence) {
         }
 
         time_vector_[id_task] = max_value;
+        RecordStartPredecessor(id_task, std::numeric_limits<size_t>::max());
       }  // } else {  // Target task
     }  // } else {  // Source and Target tasks
   }  // for (auto id_task : ordering_) {  // For each task, do
@@ -319,78 +836,54 @@ bool Solution::CheckTaskSequence(size_t task) {
 }  // bool Solution::CheckTaskSequence(size_t task) {
 
 // Check and organize the file based on the storage capacity
+/**
+ * Besides \c file_allocations_, update the number of files and the free space, in MB, of the old
+ * and of the new storage of the file.
+ *
+ * \param[in]  file_id     The file to be allocated
+ * \param[in]  storage_id  The storage that will hold the file
+ */
+void Solution::AllocateFile(size_t file_id, size_t storage_id) {
+  double size = algorithm_->GetFilePerId(file_id)->get_size_in_MB();
+
+  if (file_allocations_[file_id] != std::numeric_limits<size_t>::max()) {
+    --storage_file_count_[file_allocations_[file_id]];
+    storage_free_space_[file_allocations_[file_id]] += size;
+  }
+
+  file_allocations_[file_id] = storage_id;
+  ++storage_file_count_[storage_id];
+  storage_free_space_[storage_id] -= size;
+}  // void Solution::AllocateFile(size_t file_id, size_t storage_id)
+
+/**
+ * Recompute, from \c file_allocations_, the space used at each storage and compare it with the
+ * capacity given by \c Algorithm::get_storage_vet(); both in MB. Since the output files are only
+ * allocated at storages with enough free space (see \c AllocateOneOutputFileGreedily()), no repair
+ * is done here.
+ *
+ * \retval  fits  True if every storage holds its files
+ */
 bool Solution::checkFiles() {
-  bool flag = true;
-  size_t count = 0;
-
-  std::vector<double> aux_storage(algorithm_->get_storage_vet());
-  std::vector<size_t> aux(algorithm_->GetVirtualMachineSize());
-  iota(aux.begin(), aux.end(), 0);  // 0,1,2,3,4 ... n
-
-  std::unordered_map<int, std::vector<int>> map_file;
-
-  size_t id_storage;
-  // build file map and compute the storage
-  // for (auto it : data->file_map) {
-  // for (auto it : algorithm_->get_file_map_per_id()) {
-  for (size_t it = 0ul; it < algorithm_->GetFileSize(); ++it) {
-    File* file = algorithm_->GetFilePerId(it);
-
-    if (DynamicFile* dynamic_file = dynamic_cast<DynamicFile*>(file)) {
-      id_storage = file_allocations_[dynamic_file->get_id()];
-      auto f = map_file.insert(std::make_pair(id_storage, std::vector<int>()));
-      f.first->second.push_back(dynamic_file->get_id());
-      aux_storage[id_storage] -= dynamic_file->get_size_in_GB();
+  std::vector<double> free_space(algorithm_->get_storage_vet());
+
+  for (size_t file_id = 0ul; file_id < algorithm_->GetFileSize(); ++file_id) {
+    size_t storage_id = file_allocations_[file_id];
+
+    if (storage_id != std::numeric_limits<size_t>::max()) {
+      free_space[storage_id] -= algorithm_->GetFilePerId(file_id)->get_size_in_MB();
     }
   }
 
-  do {
-    // Sort machines based on the storage capacity
-    std::sort(aux.begin(), aux.end(), [&](const size_t &a, const size_t &b) {
-      return aux_storage[a] < aux_storage[b];
-    });
-
-    if (aux_storage[aux[0ul]] < 0.0) {  // If storage is full, start the file heuristic
-      std::cout << "Starting file heuristic ..." << std::endl;
-      size_t old_vm = aux[0];  // Critical machine
-      size_t new_storage = aux[aux.size() - 1];  // Best machine
-
-      auto vet_file = map_file.find(old_vm)->second;
-
-      double min = std::numeric_limits<double>::max();
-      // size_t min_file = -1;
-      size_t min_file = std::numeric_limits<size_t>::max();
-
-      // Search min file (based on the size of file)
-      for_each(vet_file.begin(), vet_file.end(), [&](size_t i) {
-        std::cout << i << std::endl;
-        File* file = algorithm_->GetFilePerId(i);
-        std::cout << file->get_name() << std::endl;
-        if (file->get_size_in_GB() < min) {
-          min = file->get_size_in_GB();
-          min_file = file->get_id();
-        }
-      });
-
-      File* file_min = algorithm_->GetFilePerId(min_file);
-
-      std::cout << file_min->get_name() << std::endl;
-      // MinFile will be move to machine with more empty space
-      file_allocations_[file_min->get_id()] = new_storage;
-      // Update aux Storage
-      aux_storage[old_vm] += file_min->get_size();
-      aux_storage[new_storage] -= file_min->get_size();
-      // Update mapFile structure
-      map_file[old_vm].erase(remove(map_file[old_vm].begin(), map_file[old_vm].end(), min_file),
-                             map_file[old_vm].end());
-      map_file[new_storage].push_back(min_file);
-    } else {
-      flag = false;
+  for (size_t storage_id = 0ul; storage_id < free_space.size(); ++storage_id) {
+    if (free_space[storage_id] < 0.0) {
+      DLOG(INFO) << "Storage[" << storage_id << "] exceeded by " << -free_space[storage_id]
+          << " MB";
+      return false;
     }
+  }
 
-    count++;
-  } while (flag && count < algorithm_->GetFileSize());
-  return !flag;
+  return true;
 }  // bool Solution::checkFiles() {
 
 std::ostream& Solution::write(std::ostream& os) const {
@@ -465,8 +958,29 @@ std::ostream& Solution::write(std::ostream& os) const {
   return os << std::endl;
 }  // std::ostream& Solution::write(std::ostream& os) const {
 
+/**
+ * Allocate the \c file at the storage that minimises its weighted contribution to the objective
+ * value; ties are broken by the smallest storage id. Storages without room for the \c file are
+ * skipped.
+ *
+ * The storages holding a static file in hard conflict with the \c file are skipped through the
+ * mask of \c Algorithm::IsStorageAllowed(), computed once by \c Algorithm::AnalyseHardConflicts().
+ * The resident conflicts are gathered once from the adjacency list of the \c file into
+ * \c aux_hard_conflict and \c aux_soft_conflict, so each storage is scored in O(1) and the query
+ * costs O(deg + S) with no allocation; the auxiliary vectors are cleared on the way out. Only the
+ * best storage is returned: every caller places the file there, so there is no top-k query.
+ *
+ * With \c --locality_aware_placement, the time term of the score also holds the expected time of
+ * the reads by the consumers of the \c file (see \c ComputeExpectedReadTime()) and the cost term
+ * the time a VM storage stays charged to serve them; only the write time and cost are accounted.
+ *
+ * \param[in]  file             The output file to be allocated
+ * \param[in]  virtual_machine  The VM that writes the \c file
+ * \retval     allocation_time  The time to write the \c file at the selected storage
+ */
 double Solution::AllocateOneOutputFileGreedily(File* file, VirtualMachine* virtual_machine) {
-  double objective_value = std::numeric_limits<double>::max();
+  const auto& conflicts = algorithm_->get_conflict_graph().GetConflicts(file->get_id());
+  const double finish_time = aux_start_time + aux_read_time + aux_runtime;
   double allocated_objective_value = std::numeric_limits<double>::max();
   double allocation_time = std::numeric_limits<double>::max();
   double allocation_cost = std::numeric_limits<double>::max();
@@ -476,81 +990,77 @@ double Solution::AllocateOneOutputFileGreedily(File* file, VirtualMachine* virtu
   DLOG(INFO) << "Computing time for write the File[" << file->get_id() << "] into VM["
       << virtual_machine->get_id() << "]";
 
-  // std::unordered_map<size_t, int> available_storages;
-
-  std::vector<size_t> available_storages = std::vector<size_t>(algorithm_->GetStorageSize());
-
-  for (size_t i = 0ul; i < available_storages.size(); ++i) {
-    available_storages[i] = i;
+  if (aux_soft_conflict.size() != algorithm_->GetStorageSize()) {
+    aux_hard_conflict.assign(algorithm_->GetStorageSize(), false);
+    aux_soft_conflict.assign(algorithm_->GetStorageSize(), 0.0);
   }
 
-  // Shuffle the output files for better ramdomness between the solutions
-  std::shuffle(available_storages.begin(), available_storages.end(), random_generator);
+  for (const auto& conflict : conflicts) {
+    size_t storage_id = file_allocations_[conflict.first];
 
-  // for all possible storage; compute the transfer time
-  // size_t attempts = 0;
-  for (size_t i = 0ul; i < available_storages.size(); ++i) {
-    // Storage* storage = algorithm_->GetStoragePerId(i);
-    Storage* storage = algorithm_->GetStoragePerId(available_storages[i]);
-    // 1. Calculates the File Transfer Time
-    double time = ComputeFileTransferTime(file, virtual_machine, storage, true);
+    if (storage_id != std::numeric_limits<size_t>::max()) {
+      if (conflict.second < 0) {
+        // The static files are already excluded by the storage mask; this flags the dynamic ones
+        aux_hard_conflict[storage_id] = true;
+      } else {
+        aux_soft_conflict[storage_id] += conflict.second;
+      }
+    }
+  }
 
-    // if (objective_value < std::numeric_limits<double>::max()) {
-    if (time == std::numeric_limits<double>::max()) {
-      // ++attempts;
+  for (size_t storage_id = 0ul; storage_id < algorithm_->GetStorageSize(); ++storage_id) {
+    if (!algorithm_->IsStorageAllowed(file->get_id(), storage_id)
+        || aux_hard_conflict[storage_id]) {
       continue;  // Hard-constraint
     }
 
+    if (storage_free_space_[storage_id] < file->get_size_in_MB()) {
+      continue;  // There is no room for the file
+    }
+
+    Storage* storage = algorithm_->GetStoragePerId(storage_id);
+
+    // 1. Calculates the File Transfer Time
+    double time = ComputeFileTransferTime(file, virtual_machine, storage);
+
     // 2. Calculates the File Contribution to the Cost
-    // double cost = ComputeFileCostContribution(file, virtual_machine, storage_pair.second, time);
-    double cost = ComputeFileCostContribution(file, storage, virtual_machine, aux_start_time + aux_read_time + aux_runtime + time);
-    // double cost = 0.0;
+    double cost = ComputeFileCostContribution(file, storage, virtual_machine, finish_time + time);
 
     // 3. Calculates the File Security Exposure Contribution
-    // double security_exposure = ComputeFileSecurityExposureContribution(storage_pair.second,
-    //                                                                    file);
-    double security_exposure = ComputeFileSecurityExposureContribution(storage, file);
-    // double security_exposure = Solution::ComputeSecurityExposure();
-    // double security_exposure = 0.0;
-
-    DLOG(INFO) << "time: " << time;
-    DLOG(INFO) << "cost: " << cost;
-    DLOG(INFO) << "security_exposure: " << security_exposure;
-
-    // Normalize
-    // objective_value = time;
-    // else {
-    //   min_objective_value = objective_value;
-    //   min_storage = i;
-    //   // break;
-    // }
-
-    objective_value = algorithm_->get_alpha_time() * (time / algorithm_->get_makespan_max())
-                    + algorithm_->get_alpha_budget() * (cost / algorithm_->get_budget_max())
+    double security_exposure = aux_soft_conflict[storage_id];
+
+    // 4. Estimates the time of the reads by the consumers of the file
+    double read_time = FLAGS_locality_aware_placement
+        ? ComputeExpectedReadTime(file, storage, virtual_machine) : 0.0;
+
+    // A VM storage stays charged while it serves the reads
+    double read_cost = storage_id < algorithm_->GetVirtualMachineSize()
+        ? read_time * algorithm_->GetVirtualMachinePerId(storage_id)->get_cost() : 0.0;
+
+    double objective_value = algorithm_->get_alpha_time()
+                        * ((time + read_time) / algorithm_->get_makespan_max())
+                    + algorithm_->get_alpha_budget()
+                        * ((cost + read_cost) / algorithm_->get_budget_max())
                     + algorithm_->get_alpha_security() * (security_exposure
                         / algorithm_->get_maximum_security_and_privacy_exposure());
 
     if (allocated_objective_value > objective_value) {
       allocated_objective_value = objective_value;
-      // min_storage = i;
-      // allocated_storage = available_storages[i];
-      allocated_storage = storage->get_id();
+      allocated_storage = storage_id;
       allocation_time = time;
       allocation_cost = cost;
       allocation_security_exposure = security_exposure;
-
-      if (i >= FLAGS_number_of_allocation_experiments - 1) {
-        break;
-      }
-      // break;
     }
+  }  // for (size_t storage_id = 0ul; ...) {
+
+  for (const auto& conflict : conflicts) {
+    size_t storage_id = file_allocations_[conflict.first];
 
-    // if (attempts >= FLAGS_number_of_allocation_experiments) {
-      // break;
-    // } else {
-      // ++attempts;
-    // }
-  }  // for (size_t i = 0ul; i < available_storages.size(); ++i) {
+    if (storage_id != std::numeric_limits<size_t>::max()) {
+      aux_hard_conflict[storage_id] = false;
+      aux_soft_conflict[storage_id] = 0.0;
+    }
+  }
 
   if (allocated_objective_value == std::numeric_limits<double>::max()) {
     LOG(FATAL) << "There is no storage available";
@@ -560,23 +1070,62 @@ double Solution::AllocateOneOutputFileGreedily(File* file, VirtualMachine* virtu
       << allocated_storage << "]";
 
   // Allocate file
-  file_allocations_[file->get_id()] = allocated_storage;
+  AllocateFile(file->get_id(), allocated_storage);
 
   // Store the file contribution to the makespan, cost and security exposury
-  // makespan_ += allocation_time;
   cost_ += allocation_cost;
   security_exposure_ += allocation_security_exposure;
-  // security_exposure_ = allocation_security_exposure;
 
   if (allocated_storage < algorithm_->GetVirtualMachineSize()) {
-    allocation_vm_queue_[allocated_storage] = std::max(aux_start_time + aux_read_time
-        + aux_runtime + allocation_time, allocation_vm_queue_[allocated_storage]);
+    allocation_vm_queue_[allocated_storage] = std::max(finish_time + allocation_time,
+                                                       allocation_vm_queue_[allocated_storage]);
   }
 
-  // return min_objective_value;
   return allocation_time;
 }  // double Solution::AllocateOutputFiles(...) {
 
+/**
+ * A consumer already scheduled reads the \c file from its own VM. A consumer not yet scheduled is
+ * assumed to run at the VM of the producer with probability \f$ 1 / |pred| \f$, since it is usually
+ * placed next to one of its predecessors, and at a uniformly random VM otherwise; the latter read
+ * is estimated with \c Algorithm::GetAverageReadTime(). Every read is timed as the makespan times
+ * it, by \c ComputeFileTransferTime().
+ *
+ * \param[in]  file             The dynamic file being placed
+ * \param[in]  storage          The candidate storage of the \c file
+ * \param[in]  virtual_machine  The VM that writes the \c file
+ * \retval     read_time        The expected accumulated read time of the consumers
+ */
+double Solution::ComputeExpectedReadTime(File* file,
+                                         Storage* storage,
+                                         VirtualMachine* virtual_machine) {
+  double read_time = 0.0;
+  DynamicFile* dynamic_file = dynamic_cast<DynamicFile*>(file);
+
+  if (dynamic_file == nullptr) {
+    return read_time;
+  }
+
+  double remote_read_time = algorithm_->GetAverageReadTime(file->get_id(), storage->get_id());
+  double producer_read_time = ComputeFileTransferTime(file, storage, virtual_machine);
+
+  for (Task* consumer : dynamic_file->get_consumers()) {
+    size_t vm_id = task_allocations_[consumer->get_id()];
+
+    if (vm_id != std::numeric_limits<size_t>::max()) {
+      read_time += ComputeFileTransferTime(file, storage,
+                                           algorithm_->GetVirtualMachinePerId(vm_id));
+    } else {
+      double affinity = 1.0
+          / static_cast<double>(algorithm_->GetPredecessors(consumer->get_id()).size());
+
+      read_time += affinity * producer_read_time + (1.0 - affinity) * remote_read_time;
+    }
+  }
+
+  return read_time;
+}  // double Solution::ComputeExpectedReadTime(...)
+
 /**
  * Calculates the initial task time and returns the maximum between:
  * 1. The longest execution time among all previous tasks.
@@ -845,6 +1394,23 @@ double Solution::ComputeFileCostContribution(File* file,
   return cost;
 }  // double Solution::CalculateCost() {
 
+/**
+ * \param[in]  task             The task
+ * \param[in]  virtual_machine  The VM that executes the \c task
+ * \retval     exposure         The sum of the requirements of the \c task above the VM ones
+ */
+double Solution::ComputeTaskSecurityExposure(Task* task, VirtualMachine* virtual_machine) const {
+  double exposure = 0.0;
+
+  for (size_t j = 0; j < task->get_requirements().size(); ++j) {
+    if (task->GetRequirementValue(j) > virtual_machine->GetRequirementValue(j)) {
+      exposure += task->GetRequirementValue(j) - virtual_machine->GetRequirementValue(j);
+    }
+  }
+
+  return exposure;
+}  // double Solution::ComputeTaskSecurityExposure(...) const
+
 double Solution::ComputeFileSecurityExposureContribution(Storage* storage, File* file) {
   double security_exposure = 0.0;
   // double task_exposure = 0.0;
@@ -853,21 +1419,13 @@ double Solution::ComputeFileSecurityExposureContribution(Storage* storage, File*
   DLOG(INFO) << "Calculate Security Exposure";
 
   // Accumulate the privacy_exposure
-  for (size_t i = 0ul; i < algorithm_->GetFileSize(); ++i) {
-    size_t storage1_id = file_allocations_[i];
-
-    if (storage1_id != std::numeric_limits<size_t>::max()
-        && storage->get_id() != std::numeric_limits<size_t>::max()
-        && storage1_id == storage->get_id()) {
-      // int conflict_value = algorithm_->get_conflict_graph().ReturnConflict(i, file->get_id());
-      int conflict_value = algorithm_->get_conflict_graph().ReturnConflict(file->get_id(), i);
-
-      if (conflict_value > 0) {
-        DLOG(INFO) << "File[" << i << "] has conflict with File[" << file->get_id() << "]";
-        privacy_exposure += conflict_value;  // Adds the penalts
-      }
+  for (const auto& conflict : algorithm_->get_conflict_graph().GetConflicts(file->get_id())) {
+    if (conflict.second > 0 && file_allocations_[conflict.first] == storage->get_id()) {
+      DLOG(INFO) << "File[" << conflict.first << "] has conflict with File[" << file->get_id()
+          << "]";
+      privacy_exposure += conflict.second;  // Adds the penalts
     }  // else; allocated file resides in different storage or was not allocated yet
-  }  // for (size_t i...) {
+  }
 
   // DLOG(INFO) << "task_exposure: " << task_exposure;
   DLOG(INFO) << "privacy_exposure: " << privacy_exposure;
@@ -997,19 +1555,7 @@ double Solution::ScheduleTask(Task* task, VirtualMachine* vm) {
   DLOG(INFO) << "Accumulate the task Exposure of the scheduled task";
 
   // Accumulate the task exposure
-
-  for (size_t j = 0; j < task->get_requirements().size(); ++j) {
-    size_t virtual_machine_id = task_allocations_[task->get_id()];
-
-    // If the task is allocated
-    if (virtual_machine_id != std::numeric_limits<size_t>::max()) {
-      VirtualMachine* virtual_machine = algorithm_->GetVirtualMachinePerId(virtual_machine_id);
-
-      if (task->GetRequirementValue(j) > virtual_machine->GetRequirementValue(j)) {
-        security_exposure_ += task->GetRequirementValue(j) - virtual_machine->GetRequirementValue(j);
-      }
-    }
-  }
+  security_exposure_ += ComputeTaskSecurityExposure(task, vm);
 
   DLOG(INFO) << "makespan: " << makespan_;
   DLOG(INFO) << "cost: " << cost_;
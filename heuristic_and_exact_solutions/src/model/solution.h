@@ -14,6 +14,7 @@
 #define APPROXIMATIVE_SOLUTIONS_SRC_MODEL_SOLUTION_H_
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <list>
 #include <limits>
@@ -38,6 +39,9 @@ class Solution {
   /// Copy constructor
   Solution(const Solution &other) = default;
 
+  /// Move constructor
+  Solution(Solution &&other) = default;
+
   /// Destructor
   ~Solution() { algorithm_ = nullptr; }
 
@@ -53,6 +57,12 @@ class Solution {
   /// Getter for \c objective_value_
   double get_objective_value() const { return objective_value_; }
 
+  /// Getter for \c ordering_
+  const std::vector<size_t>& get_ordering() const { return ordering_; }
+
+  /// Put the \c Task \c task_id at \c position of \c ordering_; the caller keeps it topological
+  void SetOrdering(size_t position, size_t task_id) { ordering_[position] = task_id; }
+
   /// Return the id of the Virtual Machine allocated to the \c Task identified by \c task_id
   size_t GetTaskAllocation(size_t task_id) const {
     return task_allocations_[task_id];
@@ -70,24 +80,83 @@ class Solution {
 
   /// Adds a Storage to a File
   void SetFileAllocation(size_t position, size_t storage_id) {
-    file_allocations_[position] = storage_id;
+    AllocateFile(position, storage_id);
   }
 
+  /// Return the finish time of the last task executed at the Virtual Machine \c vm_id
+  double GetExecutionVmQueue(size_t vm_id) const { return execution_vm_queue_[vm_id]; }
+
+  /// Return the finish time of the last file written into the Virtual Machine \c vm_id
+  double GetAllocationVmQueue(size_t vm_id) const { return allocation_vm_queue_[vm_id]; }
+
+  /// Return the number of files allocated to the Storage \c storage_id
+  size_t GetStorageFileCount(size_t storage_id) const { return storage_file_count_[storage_id]; }
+
+  /// Return the free space, in MB, of the Storage \c storage_id
+  double GetStorageFreeSpace(size_t storage_id) const { return storage_free_space_[storage_id]; }
+
   /// Calculate de Objective Function of the solution
   double ObjectiveFunction(bool check_storage = true, bool check_sequence = false);
 
   /// Schedule the \c task to be executed at \c virtual_machine
   double ScheduleTask(Task* task, VirtualMachine* virtual_machine);
 
+  /// Replay the makespan and the cost of the complete solution; keep the security exposure
+  double Evaluate(bool check_sequence = false);
+
+  /// Restore the makespan and the cost of a previous evaluation, after undoing a move
+  void RestoreEvaluation(double makespan, double cost);
+
+  /// Move the \c Task \c task_id to the Virtual Machine \c vm_id; evaluate if \c evaluate is set
+  double MoveTask(size_t task_id, size_t vm_id, bool evaluate = true);
+
+  /// Return true if the File \c file_id fits into the Storage \c storage_id without a hard conflict
+  bool CanMoveFile(size_t file_id,
+                   size_t storage_id,
+                   size_t ignored_file_id = std::numeric_limits<size_t>::max()) const;
+
+  /// Move the File \c file_id to the Storage \c storage_id; evaluate if \c evaluate is set
+  double MoveFile(size_t file_id, size_t storage_id, bool evaluate = true);
+
+  /// Index the ordering and the tasks of each VM, then evaluate; needed by the incremental moves
+  double PrepareIncrementalEvaluation();
+
+  /// Move the \c Task \c task_id to the VM \c vm_id; recompute only the affected finish times
+  double MoveTaskIncrementally(size_t task_id, size_t vm_id);
+
+  /// Move the File \c file_id to the Storage \c storage_id; recompute only the affected times
+  double MoveFileIncrementally(size_t file_id, size_t storage_id);
+
+  /// Estimate the VM cost change of moving the \c Task \c task_id to \c vm_id; needs the index
+  double EstimateTaskMoveCost(size_t task_id, size_t vm_id) const;
+
+  /// Return the tasks of the critical path, from the first to the last; needs a current evaluation
+  std::vector<size_t> GetCriticalPath() const;
+
+  /// Compute the exposure of the requirements of the \c task at the \c virtual_machine
+  double ComputeTaskSecurityExposure(Task* task, VirtualMachine* virtual_machine) const;
+
+  /// Return the number of integers of the encoding of a solution of the \c algorithm
+  static size_t GetEncodingSize(const Algorithm* algorithm);
+
+  /// Write the task and file allocations and the ordering into \c code, as 32-bit integers
+  void Encode(uint32_t* code) const;
+
+  /// Rebuild the allocations and the ordering written by \c Encode() into \c code; evaluate
+  double Decode(const uint32_t* code);
+
   /// Verify that que sequence of the task; terminate if the sequence is broken
   inline bool CheckTaskSequence(size_t);
 
-  /// Chek the files
+  /// Check that the allocated files fit into the storages
   inline bool checkFiles();
 
   /// Copy operator
   Solution& operator=(const Solution&) = default;
 
+  /// Move operator
+  Solution& operator=(Solution&&) = default;
+
   /// Concatenation operator
   friend std::ostream& operator<<(std::ostream& os, const Solution& a) {
     return a.write(os);
@@ -97,6 +166,9 @@ class Solution {
   /// Write this object to the output stream
   std::ostream& write(std::ostream& os) const;
 
+  /// Move the File \c file_id to the Storage \c storage_id, keeping the per storage counters
+  void AllocateFile(size_t file_id, size_t storage_id);
+
   /// Add a task id to the end of the ordering vector
   void AddOrdering(size_t task_id) {
     ordering_.push_back(task_id);
@@ -118,13 +190,16 @@ class Solution {
   double ComputeSecurityExposure();
 
   /// Compute the time for write all output files of the \c task executed at \c virtual_machine
-  inline double ComputeTaskWriteTime(Task* task, VirtualMachine* virtual_machine);
+  inline double ComputeTaskWriteTime(Task* task, VirtualMachine* virtual_machine) const;
 
   /// Compute the file transfer time
   inline double ComputeFileTransferTime(File* file,
                                         Storage* vm1,
                                         Storage* vm2,
-                                        bool check_constraints = false);
+                                        bool check_constraints = false) const;
+
+  /// Estimate the time of the reads of \c file, written by \c virtual_machine, from \c storage
+  double ComputeExpectedReadTime(File* file, Storage* storage, VirtualMachine* virtual_machine);
 
   /// Allocate just one output file selecting storage with minimal time transfer
   double AllocateOneOutputFileGreedily(File* file, VirtualMachine* vm);
@@ -142,6 +217,15 @@ class Solution {
   /// Compute the file contribution to the security exposure
   double ComputeFileSecurityExposureContribution(Storage* storage, File* file);
 
+  /// Compute the read, run and write time of the \c task at \c virtual_machine; no side effect
+  double ComputeTaskDuration(Task* task, VirtualMachine* virtual_machine) const;
+
+  /// Record the task whose finish time starts \c task_id; \c previous_task_id precedes it on its VM
+  void RecordStartPredecessor(size_t task_id, size_t previous_task_id);
+
+  /// Recompute the finish times from the \c tasks on; update the cost of the \c vms and evaluate
+  double PropagateFinishTimes(const std::vector<size_t>& tasks, std::vector<size_t>& vms);
+
   /// A pointer to the Algorithm object that contain the all necessary data
   Algorithm* algorithm_;
 
@@ -151,6 +235,12 @@ class Solution {
   /// Allocation offiles in theirs storages
   std::vector<size_t> file_allocations_;
 
+  /// Number of files allocated to each storage
+  std::vector<size_t> storage_file_count_;
+
+  /// Remaining capacity, in MB, of each storage
+  std::vector<double> storage_free_space_;
+
   /// Order of the allocated tasks
   std::vector<size_t> ordering_;
 
@@ -174,6 +264,16 @@ class Solution {
 
   /// Objective value based on \c makespan_, \c cost_ and \c security_exposure_
   double objective_value_ = std::numeric_limits<double>::max();
+
+  /// Predecessor, in the workflow or on its VM, whose finish time starts each task
+  /// (see \c Evaluate())
+  std::vector<size_t> start_predecessor_;
+
+  /// Position of each task in \c ordering_; empty until \c PrepareIncrementalEvaluation()
+  std::vector<size_t> ordering_position_;
+
+  /// Tasks of each Virtual Machine in the order of \c ordering_, for the incremental moves
+  std::vector<std::vector<size_t>> vm_sequences_;
 };
 
 #endif  // APPROXIMATIVE_SOLUTIONS_SRC_MODEL_SOLUTION_H_
@@ -61,6 +61,9 @@ class Storage {
   /// Get a requiremnt value
   int GetRequirementValue(size_t requirement_id) const { return requirements_[requirement_id]; }
 
+  /// Getter for requirements_
+  const std::vector<int>& get_requirements() const { return requirements_; }
+
   bool operator==(const Storage &rhs) const {
     return rhs.get_id() == id_;
   }
@@ -48,10 +48,10 @@ class Task {
   double get_time() const { return time_; }
 
   /// Getter for input_files_
-  std::vector<File*> get_input_files() const { return input_files_; }
+  const std::vector<File*>& get_input_files() const { return input_files_; }
 
   /// Getter for output_files_
-  std::vector<File*> get_output_files() const { return output_files_; }
+  const std::vector<File*>& get_output_files() const { return output_files_; }
 
   /// Getter for requirements_
   std::vector<int> get_requirements() const { return requirements_; }
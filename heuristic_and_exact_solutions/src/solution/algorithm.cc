@@ -16,10 +16,18 @@
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <set>
 #include <sstream>
 #include <new>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -36,8 +44,23 @@
 #include "src/model/virtual_machine.h"
 #include "src/solution/greedy_randomized_constructive_heuristic.h"
 #include "src/solution/min_min_algorithm.h"
+#include "src/solution/heft_algorithm.h"
+#include "src/solution/peft_algorithm.h"
+#include "src/solution/beam_search_algorithm.h"
+#include "src/solution/ant_colony_optimisation.h"
+#include "src/solution/iterated_local_search.h"
+#include "src/solution/large_neighbourhood_search.h"
+#include "src/solution/memetic_algorithm.h"
+#include "src/solution/nsga2_algorithm.h"
+#include "src/solution/island_model.h"
+#include "src/solution/simulated_annealing.h"
+#include "src/solution/tabu_search.h"
 #include "src/solution/cplex.h"
 
+DECLARE_bool(dominance_pruning);
+DECLARE_double(time_limit_seconds);
+DECLARE_bool(cluster_chains);
+
 void Algorithm::ReadTasksAndFiles(std::string tasks_and_files,
                                   std::unordered_map<std::string, File*>& file_map_per_name) {
   double total_file = 0.0;
@@ -211,6 +234,10 @@ void Algorithm::ReadTasksAndFiles(std::string tasks_and_files,
 
       File* my_file = file_map_per_name.find(line)->second;
       my_task->AddInputFile(my_file);
+
+      if (DynamicFile* dynamic_file = dynamic_cast<DynamicFile*>(my_file)) {
+        dynamic_file->AddConsumer(my_task);
+      }
     }
 
     // reading output files
@@ -444,8 +471,49 @@ void Algorithm::ReadCluster(std::string cluster) {
     // providers_.push_back(my_provider);
   // }
   in_cluster.close();
+
+  ComputeVirtualMachineClasses();
 }  // void Algorithm::ReadCluster(std::string cluster) {
 
+/**
+ * Two Virtual Machines are equivalent when they have the same type, slowdown, storage, bandwidth,
+ * cost and requirements; they only differ by the id. The classes are numbered in the order of
+ * their first Virtual Machine.
+ */
+void Algorithm::ComputeVirtualMachineClasses() {
+  std::vector<VirtualMachine*> representatives;
+
+  virtual_machine_class_.assign(GetVirtualMachineSize(), 0ul);
+
+  for (VirtualMachine* vm : virtual_machines_) {
+    size_t class_id = 0ul;
+
+    for (; class_id < representatives.size(); ++class_id) {
+      VirtualMachine* representative = representatives[class_id];
+
+      if (vm->get_type_id() == representative->get_type_id()
+          && vm->get_slowdown() == representative->get_slowdown()
+          && vm->get_storage() == representative->get_storage()
+          && vm->get_bandwidth() == representative->get_bandwidth()
+          && vm->get_cost() == representative->get_cost()
+          && vm->get_requirements() == representative->get_requirements()) {
+        break;
+      }
+    }
+
+    if (class_id == representatives.size()) {
+      representatives.push_back(vm);
+    }
+
+    virtual_machine_class_[vm->get_id()] = class_id;
+    DLOG(INFO) << "VM[" << vm->get_id() << "] belongs to the class " << class_id;
+  }
+
+  number_of_virtual_machine_classes_ = representatives.size();
+
+  DLOG(INFO) << number_of_virtual_machine_classes_ << " classes of Virtual Machines";
+}  // void Algorithm::ComputeVirtualMachineClasses()
+
 void Algorithm::ReadConflictGraph(std::string conflict_graph,
                                   std::unordered_map<std::string, File*>& file_map_per_name) {
   std::string line;
@@ -505,11 +573,10 @@ void Algorithm::ReadInputFiles(const std::string tasks_and_files,
     // Storage* storage = storage_pair.second;
     storage_vet_[storage->get_id()] = storage->get_storage();
   }
-  height_.resize(GetTaskSize(), -1);
-  ComputeHeight(id_source_, 0);
-  for (size_t i = 0; i < height_.size(); ++i) {
-    DLOG(INFO) << "Height[" << i << "]: " << height_[i];
-  }
+  ComputeAverageTimes();
+  ComputeTopologicalAnalysis();
+  ComputeTaskChains();
+  AnalyseHardConflicts();
   // google::FlushLogFiles(google::INFO);
   // Check if storage is enough
   // for (auto it : _file_map){
@@ -544,6 +611,28 @@ std::shared_ptr<Algorithm> Algorithm::ReturnAlgorithm(const std::string algorith
     return std::make_shared<GreedyRandomizedConstructiveHeuristic>();
   } else if (algorithm == "min_min") {
     return std::make_shared<MinMinAlgorithm>();
+  } else if (algorithm == "heft") {
+    return std::make_shared<HeftAlgorithm>();
+  } else if (algorithm == "peft") {
+    return std::make_shared<PeftAlgorithm>();
+  } else if (algorithm == "beam") {
+    return std::make_shared<BeamSearchAlgorithm>();
+  } else if (algorithm == "ils") {
+    return std::make_shared<IteratedLocalSearch>();
+  } else if (algorithm == "sa") {
+    return std::make_shared<SimulatedAnnealing>();
+  } else if (algorithm == "tabu") {
+    return std::make_shared<TabuSearch>();
+  } else if (algorithm == "memetic") {
+    return std::make_shared<MemeticAlgorithm>();
+  } else if (algorithm == "aco") {
+    return std::make_shared<AntColonyOptimisation>();
+  } else if (algorithm == "nsga2") {
+    return std::make_shared<Nsga2Algorithm>();
+  } else if (algorithm == "lns") {
+    return std::make_shared<LargeNeighbourhoodSearch>();
+  } else if (algorithm == "islands") {
+    return std::make_shared<IslandModel>();
   } else if (algorithm == "cplex") {
     return std::make_shared<Cplex>();
   } else {
@@ -567,21 +656,852 @@ std::unordered_map<size_t, std::vector<size_t>> Algorithm::ReverseMap(
   return r_map;
 }
 
-void Algorithm::ComputeHeight(size_t node, int n) {
-  // DLOG(INFO) << "node[" << node << "], n[" << n << "]";
-  // google::FlushLogFiles(google::INFO);
-  if (height_[node] < n) {
-    height_[node] = n;
-    // auto vet = successors_.find(node)->second;
-    auto vet = successors_[node];
-    for (auto j : vet) {
-      // DLOG(INFO) << "vet[" << j << "]";
-      // google::FlushLogFiles(google::INFO);
+/**
+ * One Kahn pass gives the topological order and, following it forward, the height and the downward
+ * rank of every task; following it backward, the depth and the upward rank. Heights and depths are
+ * the longest paths, in number of edges, from the source and to a sink task:
+ *
+ *   \f[
+ *      rank_u(t) = \overline{w_t} + \max_{s \in succ(t)} (\overline{c_{t,s}} + rank_u(s))
+ *   \f]
+ *   \f[
+ *      rank_d(t) = \max_{p \in pred(t)} (rank_d(p) + \overline{w_p} + \overline{c_{p,t}})
+ *   \f]
+ *
+ * Where \f$ \overline{w_t} \f$ is the average runtime of \f$ t \f$ plus the average write time of
+ * its output files and \f$ \overline{c_{t,s}} \f$ is the average read time of the files that
+ * \f$ s \f$ consumes from \f$ t \f$. A task is on the critical path when \f$ rank_u + rank_d \f$
+ * equals the longest upward rank. Must be called after \c ComputeAverageTimes().
+ */
+void Algorithm::ComputeTopologicalAnalysis() {
+  const size_t task_size = GetTaskSize();
+  std::vector<size_t> in_degree(task_size);
+  std::vector<double> weight(task_size);
+
+  topological_order_.clear();
+  topological_order_.reserve(task_size);
 
-      ComputeHeight(j, n+1);
+  for (size_t task_id = 0ul; task_id < task_size; ++task_id) {
+    in_degree[task_id] = predecessors_[task_id].size();
+
+    if (in_degree[task_id] == 0ul) {
+      topological_order_.push_back(task_id);
+    }
+
+    weight[task_id] = average_runtime_[task_id];
+
+    for (File* file : tasks_[task_id]->get_output_files()) {
+      weight[task_id] += average_file_transfer_time_[file->get_id()];
     }
   }
-}
+
+  // The order vector is also the queue of the Kahn algorithm
+  for (size_t i = 0ul; i < topological_order_.size(); ++i) {
+    for (size_t child_id : successors_[topological_order_[i]]) {
+      if (--in_degree[child_id] == 0ul) {
+        topological_order_.push_back(child_id);
+      }
+    }
+  }
+
+  if (topological_order_.size() != task_size) {
+    LOG(FATAL) << "The workflow has a cycle; only " << topological_order_.size() << " of "
+               << task_size << " tasks were ordered";
+  }
+
+  height_.assign(task_size, 0);
+  downward_rank_.assign(task_size, 0.0);
+
+  for (size_t task_id : topological_order_) {
+    for (size_t child_id : successors_[task_id]) {
+      height_[child_id] = std::max(height_[child_id], height_[task_id] + 1);
+      downward_rank_[child_id] = std::max(downward_rank_[child_id],
+                                          downward_rank_[task_id] + weight[task_id]
+                                          + ComputeAverageCommunicationTime(task_id, child_id));
+    }
+  }
+
+  depth_.assign(task_size, 0);
+  upward_rank_.assign(task_size, 0.0);
+
+  double critical_path_length = 0.0;
+
+  for (auto it = topological_order_.rbegin(); it != topological_order_.rend(); ++it) {
+    size_t task_id = *it;
+    double longest_path = 0.0;
+
+    for (size_t child_id : successors_[task_id]) {
+      depth_[task_id] = std::max(depth_[task_id], depth_[child_id] + 1);
+      longest_path = std::max(longest_path, ComputeAverageCommunicationTime(task_id, child_id)
+                                            + upward_rank_[child_id]);
+    }
+
+    upward_rank_[task_id] = weight[task_id] + longest_path;
+    critical_path_length = std::max(critical_path_length, upward_rank_[task_id]);
+  }
+
+  critical_path_.assign(task_size, false);
+
+  for (size_t task_id = 0ul; task_id < task_size; ++task_id) {
+    double length = upward_rank_[task_id] + downward_rank_[task_id];
+
+    critical_path_[task_id] = std::fabs(length - critical_path_length)
+                              <= 1e-9 * std::max(1.0, critical_path_length);
+
+    DLOG(INFO) << "Task[" << task_id << "]: height " << height_[task_id]
+               << ", depth " << depth_[task_id]
+               << ", upward rank " << upward_rank_[task_id]
+               << ", downward rank " << downward_rank_[task_id]
+               << (critical_path_[task_id] ? ", critical" : "");
+  }
+}  // void Algorithm::ComputeTopologicalAnalysis() {
+
+/**
+ * With \c --cluster_chains, a task \c u and its only successor \c v are merged when \c u is the
+ * only predecessor of \c v; the source and the target tasks are never merged. Executing a chain
+ * at a single VM makes the transfers between its tasks local, so the whole chain is one scheduling
+ * decision, taken at its head: the other tasks of the chain have the VM of their predecessor as
+ * the only probe candidate (see \c GetProbeCandidates()). They are still scheduled in the order
+ * of the algorithm, so a chain does not delay the tasks of lower height. Without the flag, every
+ * task is a chain of one task.
+ */
+void Algorithm::ComputeTaskChains() {
+  chain_successor_.assign(GetTaskSize(), std::numeric_limits<size_t>::max());
+  chain_head_.assign(GetTaskSize(), true);
+
+  if (!FLAGS_cluster_chains) {
+    return;
+  }
+
+  size_t number_of_units = GetTaskSize();
+
+  for (size_t task_id = 0ul; task_id < GetTaskSize(); ++task_id) {
+    if (task_id == id_source_ || task_id == id_target_ || successors_[task_id].size() != 1ul) {
+      continue;
+    }
+
+    size_t child_id = successors_[task_id].front();
+
+    if (child_id != id_target_ && predecessors_[child_id].size() == 1ul) {
+      chain_successor_[task_id] = child_id;
+      chain_head_[child_id] = false;
+      --number_of_units;
+    }
+  }
+
+  DLOG(INFO) << "Chain clustering: " << GetTaskSize() << " tasks in " << number_of_units
+      << " scheduling decisions";
+}  // void Algorithm::ComputeTaskChains()
+
+/**
+ * Analyse the subgraph of the hard conflicts (negative values) of the conflict graph:
+ *
+ * 1. a greedy clique, grown from each file in decreasing order of hard degree, gives a lower
+ *    bound on the number of storages needed, since the files of a clique must be pairwise apart;
+ * 2. a storage is masked for a file when it holds a static file in hard conflict with that file,
+ *    since placing the file there always violates the conflict.
+ *
+ * The placement of the output files reads the mask through \c IsStorageAllowed(). The run stops
+ * when the clique does not fit in the storages.
+ */
+void Algorithm::AnalyseHardConflicts() {
+  std::vector<std::vector<size_t>> hard_neighbours(GetFileSize());
+
+  storage_mask_.assign(GetFileSize() * GetStorageSize(), true);
+
+  for (size_t file_id = 0ul; file_id < GetFileSize(); ++file_id) {
+    for (const auto& conflict : conflict_graph_.GetConflicts(file_id)) {
+      if (conflict.second < 0 && conflict.first != file_id) {
+        hard_neighbours[file_id].push_back(conflict.first);
+      }
+    }
+  }
+
+  // 1. Greedy clique lower bound
+  std::vector<size_t> order(GetFileSize());
+
+  std::iota(order.begin(), order.end(), 0ul);
+  std::stable_sort(order.begin(), order.end(), [&hard_neighbours](size_t a, size_t b) {
+    return hard_neighbours[a].size() > hard_neighbours[b].size();
+  });
+
+  hard_conflict_clique_size_ = 0ul;
+
+  for (size_t file_id : order) {
+    if (hard_neighbours[file_id].size() < hard_conflict_clique_size_) {
+      break;  // No larger clique can contain this file
+    }
+
+    std::vector<size_t> clique = {file_id};
+
+    for (size_t candidate : hard_neighbours[file_id]) {
+      bool fits = true;
+
+      for (size_t member : clique) {
+        if (member != file_id && conflict_graph_.ReturnConflict(candidate, member) >= 0) {
+          fits = false;
+          break;
+        }
+      }
+
+      if (fits) {
+        clique.push_back(candidate);
+      }
+    }
+
+    hard_conflict_clique_size_ = std::max(hard_conflict_clique_size_, clique.size());
+  }
+
+  // 2. Storage mask
+  for (size_t file_id = 0ul; file_id < GetFileSize(); ++file_id) {
+    for (size_t neighbour : hard_neighbours[file_id]) {
+      if (StaticFile* static_file = dynamic_cast<StaticFile*>(files_[neighbour])) {
+        storage_mask_[file_id * GetStorageSize() + static_file->GetFirstVm()] = false;
+      }
+    }
+  }
+
+  DLOG(INFO) << "Hard conflicts: clique lower bound " << hard_conflict_clique_size_
+      << ", storages " << GetStorageSize();
+
+  if (hard_conflict_clique_size_ > GetStorageSize()) {
+    LOG(FATAL) << "The hard conflicts need at least " << hard_conflict_clique_size_
+        << " storages, but there are only " << GetStorageSize();
+  }
+}  // void Algorithm::AnalyseHardConflicts()
+
+/**
+ * The average runtime of a task is its base time scaled by the slowdown of each Virtual Machine.
+ * The average transfer time of a file is taken over all (Virtual Machine, Storage) pairs, using the
+ * same rule of \c Solution::ComputeFileTransferTime. The average read time of a file at a storage
+ * is taken, with the same rule, over the Virtual Machines only; it estimates the time of a read by
+ * a task at an unknown VM.
+ */
+void Algorithm::ComputeAverageTimes() {
+  average_runtime_.assign(GetTaskSize(), 0.0);
+  average_file_transfer_time_.assign(GetFileSize(), 0.0);
+  average_read_time_.assign(GetFileSize() * GetStorageSize(), 0.0);
+
+  for (Task* task : tasks_) {
+    double runtime = 0.0;
+
+    for (VirtualMachine* virtual_machine : virtual_machines_) {
+      runtime += task->get_time() * virtual_machine->get_slowdown();
+    }
+
+    average_runtime_[task->get_id()] = runtime / static_cast<double>(GetVirtualMachineSize());
+  }
+
+  double number_of_pairs = static_cast<double>(GetVirtualMachineSize() * GetStorageSize());
+
+  for (File* file : files_) {
+    double transfer_time = 0.0;
+
+    for (Storage* storage : storages_) {
+      double read_time = 0.0;
+
+      for (VirtualMachine* virtual_machine : virtual_machines_) {
+        if (virtual_machine->get_id() != storage->get_id()) {
+          double link = std::min(virtual_machine->get_bandwidth_GBps(),
+                                 storage->get_bandwidth_GBps());
+          read_time += std::ceil(file->get_size_in_GB() / link);
+        } else {
+          read_time += 1.0;
+        }
+      }
+
+      average_read_time_[file->get_id() * GetStorageSize() + storage->get_id()] = read_time
+          / static_cast<double>(GetVirtualMachineSize());
+      transfer_time += read_time;
+    }
+
+    average_file_transfer_time_[file->get_id()] = transfer_time / number_of_pairs;
+  }
+}  // void Algorithm::ComputeAverageTimes() {
+
+/**
+ * Only the files written by \c task_id and read by \c child_id are considered; the write into the
+ * storage is accounted to the producer, hence this is the average read time of the child.
+ *
+ * \param[in]  task_id   The producer task
+ * \param[in]  child_id  A successor of the \c task_id
+ * \retval     time      The accumulated average transfer time
+ */
+double Algorithm::ComputeAverageCommunicationTime(size_t task_id, size_t child_id) {
+  double time = 0.0;
+
+  for (File* file : tasks_[child_id]->get_input_files()) {
+    if (DynamicFile* dynamic_file = dynamic_cast<DynamicFile*>(file)) {
+      Task* parent_task = dynamic_file->get_parent_task();
+
+      if (parent_task != nullptr && parent_task->get_id() == task_id) {
+        time += average_file_transfer_time_[file->get_id()];
+      }
+    }
+  }
+
+  return time;
+}  // double Algorithm::ComputeAverageCommunicationTime(...)
+
+/**
+ * Initialize the allocation with the static files place information (VM or Bucket)
+ *
+ * \param[in]  solution  The solution to be initialized
+ */
+void Algorithm::AllocateStaticFiles(Solution& solution) {
+  for (File* file : files_) {
+    if (StaticFile* static_file = dynamic_cast<StaticFile*>(file)) {
+      solution.SetFileAllocation(file->get_id(), static_file->GetFirstVm());
+    }
+  }
+}  // void Algorithm::AllocateStaticFiles(Solution& solution) {
+
+/**
+ * Unlike \c std::stod(), nothing is thrown: the whole trimmed \c token must be the number, so
+ * "0.5x", "" and "nan" are all rejected.
+ *
+ * \param[in]   token  The text to be parsed
+ * \param[out]  value  The parsed number, if any
+ * \retval      true   If \c token is a finite number
+ */
+bool Algorithm::ParseNumber(std::string token, double& value) {
+  char* end = nullptr;
+
+  boost::trim(token);
+
+  if (token.empty()) {
+    return false;
+  }
+
+  value = std::strtod(token.c_str(), &end);
+
+  return end == token.c_str() + token.size() && std::isfinite(value);
+}  // bool Algorithm::ParseNumber(std::string token, double& value)
+
+/**
+ * A task inside a chain (see \c ComputeTaskChains()) has only the VM of its predecessor.
+ *
+ * Two Virtual Machines of the same class that store no file and have the same execution and
+ * allocation queues give the same objective value to any task, so only the first of them is
+ * returned. Virtual Machines storing files are always returned, since the read times depend on it.
+ *
+ * With \c --dominance_pruning, a candidate \c a is also discarded when another candidate \c b
+ * that stores no file dominates it for the \c task:
+ *
+ * 1. \c b is not slower, not more expensive and has no smaller bandwidth than \c a;
+ * 2. the exposure of the \c task at \c b is not greater than at \c a;
+ * 3. \c b is free no later than \c a, and the idle time charged by \c b until the current
+ *    makespan is not more expensive than the one charged by \c a;
+ * 4. \c a stores none of the input files of the \c task;
+ * 5. \c b has no less free space than \c a, so every output file that fits at \c a fits at \c b.
+ *
+ * Under these conditions \c b finishes the \c task no later and with no greater cost nor
+ * exposure, so \c a never wins the weighted objective. Ties are broken by the smallest id.
+ *
+ * \param[in]  task        The task to be scheduled
+ * \param[in]  solution    The partial solution that will receive the \c task
+ * \retval     candidates  The Virtual Machines to be probed, in increasing order of id
+ */
+std::vector<VirtualMachine*> Algorithm::GetProbeCandidates(Task* task, const Solution& solution) {
+  std::vector<VirtualMachine*> candidates;
+  std::set<std::tuple<size_t, double, double>> probed_states;
+
+  // Inside a chain, the task follows its predecessor
+  if (!chain_head_[task->get_id()]) {
+    size_t vm_id = solution.GetTaskAllocation(predecessors_[task->get_id()].front());
+
+    if (vm_id != std::numeric_limits<size_t>::max()) {
+      candidates.push_back(virtual_machines_[vm_id]);
+      return candidates;
+    }
+  }
+
+  candidates.reserve(GetVirtualMachineSize());
+
+  for (VirtualMachine* vm : virtual_machines_) {
+    size_t vm_id = vm->get_id();
+
+    if (solution.GetStorageFileCount(vm_id) == 0ul) {
+      auto state = std::make_tuple(virtual_machine_class_[vm_id],
+                                   solution.GetExecutionVmQueue(vm_id),
+                                   solution.GetAllocationVmQueue(vm_id));
+
+      if (!probed_states.insert(state).second) {
+        continue;
+      }
+    }
+
+    candidates.push_back(vm);
+  }
+
+  number_of_probe_candidates_ += GetVirtualMachineSize();
+  number_of_collapsed_candidates_ += GetVirtualMachineSize() - candidates.size();
+
+  if (!FLAGS_dominance_pruning || candidates.size() < 2ul) {
+    return candidates;
+  }
+
+  const double makespan = solution.get_makespan();
+  const size_t number_of_requirements = task->get_requirements().size();
+  std::vector<double> exposure(candidates.size(), 0.0);
+  std::vector<bool> stores_input(candidates.size(), false);
+
+  // With chain clustering, the whole chain of the task goes to the VM
+  for (size_t i = 0ul; i < candidates.size(); ++i) {
+    for (Task* member = task; member != nullptr; member = GetChainSuccessor(member)) {
+      for (size_t j = 0ul; j < number_of_requirements; ++j) {
+        int diff = member->GetRequirementValue(j) - candidates[i]->GetRequirementValue(j);
+
+        if (diff > 0) {
+          exposure[i] += diff;
+        }
+      }
+
+      if (solution.GetStorageFileCount(candidates[i]->get_id()) > 0ul) {
+        for (File* file : member->get_input_files()) {
+          if (solution.GetFileAllocation(file->get_id()) == candidates[i]->get_id()) {
+            stores_input[i] = true;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  auto dominates = [&](size_t b, size_t a) {
+    VirtualMachine* vm_b = candidates[b];
+    VirtualMachine* vm_a = candidates[a];
+    double queue_b = solution.GetExecutionVmQueue(vm_b->get_id());
+    double queue_a = solution.GetExecutionVmQueue(vm_a->get_id());
+    double free_space_b = solution.GetStorageFreeSpace(vm_b->get_id());
+    double free_space_a = solution.GetStorageFreeSpace(vm_a->get_id());
+
+    if (stores_input[a] || solution.GetStorageFileCount(vm_b->get_id()) > 0ul
+        || vm_b->get_slowdown() > vm_a->get_slowdown()
+        || vm_b->get_cost() > vm_a->get_cost()
+        || vm_b->get_bandwidth() < vm_a->get_bandwidth()
+        || exposure[b] > exposure[a]
+        || queue_b > queue_a
+        || free_space_b < free_space_a
+        || (makespan - queue_b) * vm_b->get_cost() > (makespan - queue_a) * vm_a->get_cost()) {
+      return false;
+    }
+
+    bool equal = vm_b->get_slowdown() == vm_a->get_slowdown()
+        && vm_b->get_cost() == vm_a->get_cost()
+        && vm_b->get_bandwidth() == vm_a->get_bandwidth()
+        && exposure[b] == exposure[a]
+        && queue_b == queue_a
+        && free_space_b == free_space_a;
+
+    return !equal || vm_b->get_id() < vm_a->get_id();
+  };
+
+  std::vector<VirtualMachine*> non_dominated;
+
+  non_dominated.reserve(candidates.size());
+
+  for (size_t a = 0ul; a < candidates.size(); ++a) {
+    bool dominated = false;
+
+    for (size_t b = 0ul; b < candidates.size() && !dominated; ++b) {
+      dominated = b != a && dominates(b, a);
+    }
+
+    if (!dominated) {
+      non_dominated.push_back(candidates[a]);
+    }
+  }
+
+  number_of_pruned_candidates_ += candidates.size() - non_dominated.size();
+
+  return non_dominated;
+}  // std::vector<VirtualMachine*> Algorithm::GetProbeCandidates(...)
+
+/**
+ * The algorithms check the deadline between iterations (or nodes), so it can be exceeded by the
+ * duration of one of them.
+ *
+ * \retval  reached  True if the elapsed time is at least \c --time_limit_seconds
+ */
+bool Algorithm::IsTimeLimitReached() const {
+  return GetElapsedTime() >= FLAGS_time_limit_seconds;
+}  // bool Algorithm::IsTimeLimitReached() const
+
+/**
+ * \retval  remaining_time  The seconds until the \c --time_limit_seconds deadline
+ */
+double Algorithm::GetRemainingTime() const {
+  return std::max(0.0, FLAGS_time_limit_seconds - GetElapsedTime());
+}  // double Algorithm::GetRemainingTime() const
+
+/**
+ * Print, to the standard output, one line with the format:
+ *
+ *     incumbent <elapsed seconds> <objective value> <makespan> <cost> <normalised exposure>
+ *
+ * The exposure is divided by the maximum security and privacy exposure, as in the final line of
+ * the standard error.
+ */
+void Algorithm::ReportIncumbent(double objective_value,
+                                double makespan,
+                                double cost,
+                                double security_exposure) const {
+  std::cout << "incumbent " << GetElapsedTime()
+      << " " << objective_value
+      << " " << makespan
+      << " " << cost
+      << " " << security_exposure / maximum_security_and_privacy_exposure_
+      << std::endl;
+}  // void Algorithm::ReportIncumbent(...) const
+
+/**
+ * In a silent run (see \c RunSilently()), as those of the alpha grid and of the islands, the
+ * \c solution is also kept as the result of the run.
+ *
+ * \param[in]  solution  The new incumbent solution
+ */
+void Algorithm::ReportIncumbent(const Solution& solution) const {
+  ReportIncumbent(solution.get_objective_value(),
+                  solution.get_makespan(),
+                  solution.get_cost(),
+                  solution.get_security_exposure());
+
+  if (keep_incumbent_) {
+    incumbent_.assign(1ul, solution);
+  }
+}  // void Algorithm::ReportIncumbent(const Solution& solution) const
+
+/**
+ * The schedule goes to the log and to the standard output. The makespan, the cost, the normalised
+ * exposure and the objective value, then the elapsed time, go to the error output, from which
+ * \c run-batch.py reads them. The statistics of the algorithm, if any, are printed afterwards.
+ *
+ * In a silent run (see \c RunSilently()), the \c solution replaces the last incumbent as the result
+ * of the run.
+ *
+ * \param[in]  solution  The final solution, evaluated from scratch
+ */
+void Algorithm::ReportSolution(const Solution& solution) const {
+  LOG(INFO) << solution;
+  std::cout << solution;
+
+  std::cerr << solution.get_makespan()
+      << " " << solution.get_cost()
+      << " " << solution.get_security_exposure() / maximum_security_and_privacy_exposure_
+      << " " << solution.get_objective_value() << std::endl
+      << GetElapsedTime() << std::endl;
+
+  if (keep_incumbent_) {
+    incumbent_.assign(1ul, solution);
+  }
+}  // void Algorithm::ReportSolution(const Solution& solution) const
+
+/**
+ * The \c alpha_grid is either a step, as "0.25", giving every triple of multiples of the step
+ * that sum to one, or a file with one triple per line, separated by commas or blanks; the empty
+ * lines and the lines starting with '#' are skipped. The weights of a triple must be non-negative
+ * numbers, not all zero (see \c ParseNumber()); the run stops at the first invalid line. The
+ * instance, the tables computed while reading it and the probe caches are shared by all the runs;
+ * the time limit applies to each run.
+ *
+ * The final solution of each run is kept (see \c RunSilently()); the solutions of the three
+ * nearest triples already solved, by the L1 distance of the weights, are the warm starts of the
+ * next run (see \c ConstructInitialSolution()). The output of the runs is discarded; one CSV row
+ * per triple is printed instead, with the values of its final solution: those given to
+ * \c ReportSolution() come from a full replay, not from the incremental deltas of the search.
+ * Only the algorithms that report a \c Solution can run the grid: \c main() rejects the CPLEX
+ * one, whose callback reports only values; a run that still reports no solution gets empty value
+ * fields.
+ *
+ * \param[in]  alpha_grid  The step, or the file of triples
+ */
+void Algorithm::RunAlphaGrid(const std::string& alpha_grid) {
+  std::vector<std::array<double, 3>> triples;
+  std::vector<Solution> results;
+  std::vector<std::array<double, 3>> solved_triples;
+  char* end = nullptr;
+  double step = std::strtod(alpha_grid.c_str(), &end);
+
+  if (end != alpha_grid.c_str() && *end == '\0') {
+    double divisions = std::round(1.0 / step);
+
+    if (step <= 0.0 || step > 1.0 || std::fabs(divisions * step - 1.0) > 1e-9) {
+      LOG(FATAL) << "The alpha grid step must divide one: " << alpha_grid;
+    }
+
+    size_t n = static_cast<size_t>(divisions);
+
+    for (size_t i = 0ul; i <= n; ++i) {
+      for (size_t j = 0ul; i + j <= n; ++j) {
+        triples.push_back({static_cast<double>(i) / divisions, static_cast<double>(j) / divisions,
+                           static_cast<double>(n - i - j) / divisions});
+      }
+    }
+  } else {
+    std::ifstream in_grid(alpha_grid);
+    std::string line;
+    size_t line_number = 0ul;
+
+    if (!in_grid.is_open()) {
+      LOG(FATAL) << "Could not open the alpha grid " << alpha_grid;
+    }
+
+    while (std::getline(in_grid, line)) {
+      std::vector<std::string> tokens;
+      std::array<double, 3> triple;
+
+      ++line_number;
+      boost::trim(line);
+
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+
+      boost::split(tokens, line, boost::is_any_of(", \t"), boost::token_compress_on);
+
+      if (tokens.size() != 3ul || !ParseNumber(tokens[0], triple[0])
+          || !ParseNumber(tokens[1], triple[1]) || !ParseNumber(tokens[2], triple[2])
+          || triple[0] < 0.0 || triple[1] < 0.0 || triple[2] < 0.0
+          || triple[0] + triple[1] + triple[2] <= 0.0) {
+        LOG(FATAL) << alpha_grid << ":" << line_number << ": invalid alpha triple \"" << line
+            << "\"; expected three non-negative numbers, not all zero";
+      }
+
+      triples.push_back(triple);
+    }
+  }
+
+  std::cout << "alpha_time,alpha_budget,alpha_security,makespan,cost,security_exposure,"
+      << "objective_value,time" << std::endl;
+
+  for (const std::array<double, 3>& triple : triples) {
+    std::vector<std::pair<double, size_t>> neighbours;
+
+    for (size_t i = 0ul; i < solved_triples.size(); ++i) {
+      neighbours.emplace_back(std::fabs(solved_triples[i][0] - triple[0])
+                              + std::fabs(solved_triples[i][1] - triple[1])
+                              + std::fabs(solved_triples[i][2] - triple[2]), i);
+    }
+
+    std::sort(neighbours.begin(), neighbours.end());
+    neighbours.resize(std::min<size_t>(neighbours.size(), 3ul));
+
+    std::vector<Solution> warm_starts;
+
+    for (const std::pair<double, size_t>& neighbour : neighbours) {
+      warm_starts.push_back(results[neighbour.second]);
+    }
+
+    Solution solution(this);
+
+    SetAlphas(triple[0], triple[1], triple[2], alpha_restrict_candidate_list_);
+    start_time_ = std::chrono::steady_clock::now();
+
+    bool solved = RunSilently(warm_starts, solution);
+    double time_s = GetElapsedTime();
+
+    std::cout << triple[0] << "," << triple[1] << "," << triple[2] << ",";
+
+    if (!solved) {
+      std::cout << ",,,," << time_s << std::endl;  // The algorithm reported no solution
+      continue;
+    }
+
+    std::cout << solution.get_makespan()
+        << "," << solution.get_cost()
+        << "," << solution.get_security_exposure() / maximum_security_and_privacy_exposure_
+        << "," << solution.get_objective_value()
+        << "," << time_s << std::endl;
+
+    results.push_back(solution);
+    solved_triples.push_back(triple);
+  }
+}  // void Algorithm::RunAlphaGrid(const std::string& alpha_grid)
+
+/**
+ * The standard and the error outputs of \c Run() are discarded. The incumbent is the last solution
+ * given to \c ReportIncumbent() or \c ReportSolution(); the \c warm_starts are offered to the
+ * initial solution (see \c ConstructInitialSolution()). The time limit is not reset.
+ *
+ * \param[in]   warm_starts  Solutions of this algorithm the run may start from
+ * \param[out]  incumbent    The best solution reported by the run
+ * \retval      reported     False if the run reported no solution; \c incumbent is then unchanged
+ */
+bool Algorithm::RunSilently(const std::vector<Solution>& warm_starts, Solution& incumbent) {
+  std::ostringstream discarded;
+  std::streambuf* out_buffer = std::cout.rdbuf();
+  std::streambuf* err_buffer = std::cerr.rdbuf();
+
+  warm_starts_ = warm_starts;
+  keep_incumbent_ = true;
+  incumbent_.clear();
+
+  std::cout.rdbuf(discarded.rdbuf());
+  std::cerr.rdbuf(discarded.rdbuf());
+  Run();
+  std::cout.rdbuf(out_buffer);
+  std::cerr.rdbuf(err_buffer);
+
+  keep_incumbent_ = false;
+  warm_starts_.clear();
+
+  if (incumbent_.empty()) {
+    return false;
+  }
+
+  incumbent = incumbent_.front();
+  incumbent_.clear();
+
+  return true;
+}  // bool Algorithm::RunSilently(const std::vector<Solution>& warm_starts, Solution& incumbent)
+
+/**
+ * Print to the standard output how many Virtual Machine probes were avoided by the equivalence
+ * classes and by the dominance pruning.
+ */
+void Algorithm::ReportProbeStatistics() const {
+  size_t probes = number_of_probe_candidates_.load();
+  size_t collapsed = number_of_collapsed_candidates_.load();
+  size_t pruned = number_of_pruned_candidates_.load();
+
+  if (probes == 0ul) {
+    return;
+  }
+
+  double total = static_cast<double>(probes);
+
+  std::cout << "VM probes: " << probes
+      << " collapsed by class: " << collapsed
+      << " (" << 100.0 * static_cast<double>(collapsed) / total << "%)"
+      << " pruned by dominance: " << pruned
+      << " (" << 100.0 * static_cast<double>(pruned) / total << "%)"
+      << std::endl;
+}  // void Algorithm::ReportProbeStatistics() const
+
+/**
+ * Probe every candidate Virtual Machine (see \c GetProbeCandidates()) and keep the one with the
+ * minimal objective value. Draws are broken
+ * by the cheapest and then by the fastest Virtual Machine, as in the Min-Min algorithm.
+ *
+ * When \c bias is given, \c bias[vm_id] is added to the objective value of the probe at the
+ * Virtual Machine \c vm_id before the comparison; the returned value is not biased.
+ *
+ * \param[in]  task             Task to be scheduled
+ * \param[in]  solution         The partial solution that will receive the \c task
+ * \param[in]  bias             Optional per Virtual Machine value added to the probes
+ * \retval     objective_value  The objective value of \c solution after the scheduling
+ */
+double Algorithm::ScheduleTaskAtBestVirtualMachine(Task* task, Solution& solution,
+                                                   const double* bias) {
+  double minimal_objective_value = std::numeric_limits<double>::max();
+  VirtualMachine* minimal_vm = nullptr;
+  Solution best_solution = solution;
+  Solution new_solution = solution;
+
+  for (VirtualMachine* vm : GetProbeCandidates(task, solution)) {
+    new_solution = solution;
+
+    double objective_value = new_solution.ScheduleTask(task, vm);
+
+    if (bias != nullptr) {
+      objective_value += bias[vm->get_id()];
+    }
+
+    if (minimal_vm == nullptr
+        || objective_value < minimal_objective_value
+        || (objective_value == minimal_objective_value
+            && vm->get_cost() < minimal_vm->get_cost())
+        || (objective_value == minimal_objective_value
+            && vm->get_cost() == minimal_vm->get_cost()
+            && vm->get_slowdown() < minimal_vm->get_slowdown())) {
+      minimal_objective_value = objective_value;
+      minimal_vm = vm;
+      std::swap(best_solution, new_solution);
+    }
+  }
+
+  DLOG(INFO) << "Task[" << task->get_id() << "] scheduled at VM[" << minimal_vm->get_id() << "]";
+
+  std::swap(solution, best_solution);
+
+  return solution.get_objective_value();
+}  // double Algorithm::ScheduleTaskAtBestVirtualMachine(...)
+
+/**
+ * The Hamming distance between the task to VM and the file to storage assignments; the static files
+ * never differ.
+ *
+ * \param[in]  a         A solution
+ * \param[in]  b         Another solution
+ * \retval     distance  The number of different assignments
+ */
+size_t Algorithm::ComputeDistance(const Solution& a, const Solution& b) const {
+  size_t distance = 0ul;
+
+  for (size_t task_id = 0ul; task_id < GetTaskSize(); ++task_id) {
+    if (a.GetTaskAllocation(task_id) != b.GetTaskAllocation(task_id)) {
+      ++distance;
+    }
+  }
+
+  for (size_t file_id = 0ul; file_id < GetFileSize(); ++file_id) {
+    if (a.GetFileAllocation(file_id) != b.GetFileAllocation(file_id)) {
+      ++distance;
+    }
+  }
+
+  return distance;
+}  // size_t Algorithm::ComputeDistance(const Solution& a, const Solution& b) const
+
+/**
+ * The HEFT rule: the tasks are ordered by height and, inside the same height, by decreasing upward
+ * rank, and each one is scheduled at its best Virtual Machine. A scheduled task records the partial
+ * makespan as its finish time (see \c Solution::ScheduleTask), so a pure rank order would delay
+ * every branch behind the critical one; the height keeps the branches parallel. The complete
+ * solution is evaluated with \c Solution::ObjectiveFunction().
+ *
+ * \param[in]  solution  An empty solution; receives the static files and every task
+ */
+void Algorithm::ConstructGreedySolution(Solution& solution) {
+  std::vector<Task*> task_list(tasks_);
+
+  std::sort(task_list.begin(), task_list.end(), [&](const Task* a, const Task* b) {
+    if (height_[a->get_id()] != height_[b->get_id()]) {
+      return height_[a->get_id()] < height_[b->get_id()];
+    }
+    return GetUpwardRank(a->get_id()) > GetUpwardRank(b->get_id());
+  });
+
+  AllocateStaticFiles(solution);
+
+  DLOG(INFO) << "Doing scheduling";
+  for (Task* task : task_list) {
+    ScheduleTaskAtBestVirtualMachine(task, solution);
+  }
+
+  DLOG(INFO) << "Scheduling done";
+
+  solution.ObjectiveFunction(false, false);
+}  // void Algorithm::ConstructGreedySolution(Solution& solution)
+
+/**
+ * The warm starts are evaluated again for the current weights; outside a silent run (see
+ * \c RunSilently()) there are none, and this is \c ConstructGreedySolution().
+ *
+ * \param[in]  solution  An empty solution that receives the initial solution
+ */
+void Algorithm::ConstructInitialSolution(Solution& solution) {
+  ConstructGreedySolution(solution);
+
+  for (Solution& warm_start : warm_starts_) {
+    warm_start.ObjectiveFunction(false, false);
+
+    if (warm_start.get_objective_value() < solution.get_objective_value()) {
+      solution = warm_start;
+    }
+  }
+}  // void Algorithm::ConstructInitialSolution(Solution& solution)
 
 // void Algorithm::ComputeHeight(int node, int n) {
 //   if (height[node] < n) {
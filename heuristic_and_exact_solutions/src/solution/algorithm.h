@@ -13,6 +13,9 @@
 #ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_ALGORITHM_H_
 #define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_ALGORITHM_H_
 
+#include <atomic>
+#include <chrono>
+#include <limits>
 #include <string>
 #include <memory>
 #include <unordered_map>
@@ -65,6 +68,38 @@ class Algorithm {
   /// Getter for \c height_
   std::vector<int>& get_height() { return height_; }
 
+  /// Getter for \c depth_
+  const std::vector<int>& get_depth() const { return depth_; }
+
+  /// Getter for \c topological_order_
+  const std::vector<size_t>& get_topological_order() const { return topological_order_; }
+
+  /// Return the upward rank of the \c Task identified by \c task_id
+  double GetUpwardRank(size_t task_id) const { return upward_rank_[task_id]; }
+
+  /// Return the downward rank of the \c Task identified by \c task_id
+  double GetDownwardRank(size_t task_id) const { return downward_rank_[task_id]; }
+
+  /// Return true if the \c Task identified by \c task_id is on the critical path
+  bool IsOnCriticalPath(size_t task_id) const { return critical_path_[task_id]; }
+
+  /// Return the next task of the chain of \c task, or nullptr; always nullptr without clustering
+  Task* GetChainSuccessor(const Task* task) const {
+    size_t next = chain_successor_[task->get_id()];
+    return next == std::numeric_limits<size_t>::max() ? nullptr : tasks_[next];
+  }
+
+  /// Return true if the \c Task identified by \c task_id starts a chain; true without clustering
+  bool IsChainHead(size_t task_id) const { return chain_head_[task_id]; }
+
+  /// Return false if the \c File \c file_id can never be placed at \c storage_id (hard conflict)
+  bool IsStorageAllowed(size_t file_id, size_t storage_id) const {
+    return storage_mask_[file_id * storages_.size() + storage_id];
+  }
+
+  /// Getter for \c hard_conflict_clique_size_
+  size_t get_hard_conflict_clique_size() const { return hard_conflict_clique_size_; }
+
   /// Getter for \c bucket_size_
   size_t get_bucket_size() { return bucket_size_; }
 
@@ -95,6 +130,14 @@ class Algorithm {
   /// Return a pointer to the \c VirtualMachine identified by \c id
   VirtualMachine* GetVirtualMachinePerId(size_t id) { return virtual_machines_[id]; }
 
+  /// Return the equivalence class of the \c VirtualMachine identified by \c vm_id
+  size_t GetVirtualMachineClass(size_t vm_id) const { return virtual_machine_class_[vm_id]; }
+
+  /// Getter for \c number_of_virtual_machine_classes_
+  size_t get_number_of_virtual_machine_classes() const {
+    return number_of_virtual_machine_classes_;
+  }
+
   /// Return a pointer to the \c Requirement identified by \c id
   Requirement GetRequirementPerId(size_t id) { return requirements_[id]; }
 
@@ -104,6 +147,22 @@ class Algorithm {
   /// Return a reference to the predecessors of the \c Task identified by \c task_id
   std::vector<size_t>& GetPredecessors(size_t task_id) { return predecessors_[task_id]; }
 
+  /// Return the average runtime of the \c Task identified by \c task_id over all VMs
+  double GetAverageRuntime(size_t task_id) const { return average_runtime_[task_id]; }
+
+  /// Return the average transfer time of the \c File identified by \c file_id
+  double GetAverageFileTransferTime(size_t file_id) const {
+    return average_file_transfer_time_[file_id];
+  }
+
+  /// Return the average, over the VMs, of the time to read the \c File \c file_id at \c storage_id
+  double GetAverageReadTime(size_t file_id, size_t storage_id) const {
+    return average_read_time_[file_id * storages_.size() + storage_id];
+  }
+
+  /// Return the average time to transfer the files produced by \c task_id and read by \c child_id
+  double ComputeAverageCommunicationTime(size_t task_id, size_t child_id);
+
   /// Getter for makespan_max_
   double get_makespan_max() const { return makespan_max_; }
 
@@ -138,6 +197,41 @@ class Algorithm {
   ///
   void CalculateMaximumSecurityAndPrivacyExposure();
 
+  /// Return the number of tasks and files allocated differently by \c a and \c b
+  size_t ComputeDistance(const Solution& a, const Solution& b) const;
+
+  /// Print the number of Virtual Machine probes avoided by classes and by dominance
+  void ReportProbeStatistics() const;
+
+  /// Return the wall-clock time, in seconds, since the creation of the algorithm
+  double GetElapsedTime() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+  }
+
+  /// Return true when the \c --time_limit_seconds deadline has passed
+  bool IsTimeLimitReached() const;
+
+  /// Return the seconds left until the \c --time_limit_seconds deadline; zero if it has passed
+  double GetRemainingTime() const;
+
+  /// Print a line with the elapsed time and the values of a new incumbent solution
+  void ReportIncumbent(double objective_value,
+                       double makespan,
+                       double cost,
+                       double security_exposure) const;
+
+  /// Print a line with the elapsed time and the values of the new incumbent \c solution
+  void ReportIncumbent(const Solution& solution) const;
+
+  /// Print the final \c solution of \c Run(), with its values and the elapsed time
+  void ReportSolution(const Solution& solution) const;
+
+  /// Run without output from the \c warm_starts; copy the last incumbent, if any, into \c incumbent
+  bool RunSilently(const std::vector<Solution>& warm_starts, Solution& incumbent);
+
+  /// Run the algorithm for each alpha triple of \c alpha_grid; print one CSV row per triple
+  void RunAlphaGrid(const std::string& alpha_grid);
+
   /**
    * \brief Executes the algorithm.
    */
@@ -158,7 +252,39 @@ class Algorithm {
 
   void ReadConflictGraph(std::string, std::unordered_map<std::string, File*>&);
 
-  void ComputeHeight(size_t, int);
+  /// Group the identical Virtual Machines into equivalence classes
+  void ComputeVirtualMachineClasses();
+
+  /// Return the Virtual Machines that must be probed to schedule the \c task into \c solution
+  std::vector<VirtualMachine*> GetProbeCandidates(Task* task, const Solution& solution);
+
+  /// Compute the topological order, heights, depths, ranks and the critical path; one Kahn pass
+  void ComputeTopologicalAnalysis();
+
+  /// Merge the single-predecessor/single-successor chains into super-tasks
+  void ComputeTaskChains();
+
+  /// Compute the storage lower bound and the storage mask of the hard conflicts
+  void AnalyseHardConflicts();
+
+  /// Compute the average runtime of the tasks and the average transfer time of the files
+  void ComputeAverageTimes();
+
+  /// Allocate the static files into their fixed storages
+  void AllocateStaticFiles(Solution& solution);
+
+  /// Parse the trimmed \c token into \c value; return false if it is empty or not a finite number
+  static bool ParseNumber(std::string token, double& value);
+
+  /// Schedule the \c task at the Virtual Machine that minimises the objective value of \c solution
+  double ScheduleTaskAtBestVirtualMachine(Task* task, Solution& solution,
+                                          const double* bias = nullptr);
+
+  /// Build and evaluate a complete solution with the HEFT order and best VM rule
+  void ConstructGreedySolution(Solution& solution);
+
+  /// Build the HEFT solution; take instead the best of \c warm_starts_ if it is better
+  void ConstructInitialSolution(Solution& solution);
 
   size_t static_file_size_;
 
@@ -188,6 +314,12 @@ class Algorithm {
 
   std::vector<VirtualMachine*> virtual_machines_;
 
+  /// Equivalence class of each Virtual Machine
+  std::vector<size_t> virtual_machine_class_;
+
+  /// Number of the Virtual Machine equivalence classes
+  size_t number_of_virtual_machine_classes_ = 0ul;
+
   // Workflow task Graphs
   std::vector<std::vector<size_t>> successors_;
 
@@ -196,8 +328,45 @@ class Algorithm {
   /// Number of the buckets
   size_t bucket_size_ = 0ul;
 
+  /// Tasks in topological order
+  std::vector<size_t> topological_order_;
+
+  /// Longest path, in number of edges, from a root task
   std::vector<int> height_;
 
+  /// Longest path, in number of edges, to a sink task
+  std::vector<int> depth_;
+
+  /// Longest average time from the start of the task to the end of the workflow
+  std::vector<double> upward_rank_;
+
+  /// Longest average time from the begin of the workflow to the start of the task
+  std::vector<double> downward_rank_;
+
+  /// Whether the task is on the critical path, measured with the average times
+  std::vector<bool> critical_path_;
+
+  /// Next task of the chain of each task, or the maximum size_t at the end of the chain
+  std::vector<size_t> chain_successor_;
+
+  /// Whether each task is the first task of its chain; every task is without clustering
+  std::vector<bool> chain_head_;
+
+  /// Whether each (file, storage) pair is free of hard conflicts with the static files; row-major
+  std::vector<bool> storage_mask_;
+
+  /// Size of a clique of hard conflicts; a lower bound on the storages needed
+  size_t hard_conflict_clique_size_ = 0ul;
+
+  /// Average runtime of each task over all Virtual Machines
+  std::vector<double> average_runtime_;
+
+  /// Average transfer time of each file between a Virtual Machine and a Storage
+  std::vector<double> average_file_transfer_time_;
+
+  /// Average read time of each (file, storage) pair over the Virtual Machines; row-major
+  std::vector<double> average_read_time_;
+
   ConflictGraph conflict_graph_;
 
   /// The weight of the time
@@ -214,7 +383,26 @@ class Algorithm {
 
   double maximum_security_and_privacy_exposure_;
 
-  clock_t t_start = clock();
+  /// Number of Virtual Machines considered by \c GetProbeCandidates(); atomic for the threads
+  std::atomic<size_t> number_of_probe_candidates_{0ul};
+
+  /// Number of Virtual Machines skipped because of an equivalent one
+  std::atomic<size_t> number_of_collapsed_candidates_{0ul};
+
+  /// Number of Virtual Machines skipped because of a dominating one
+  std::atomic<size_t> number_of_pruned_candidates_{0ul};
+
+  /// Start of the wall-clock time measured by \c GetElapsedTime()
+  std::chrono::steady_clock::time_point start_time_ = std::chrono::steady_clock::now();
+
+  /// Solutions the next run starts from, given by \c RunSilently()
+  std::vector<Solution> warm_starts_;
+
+  /// Whether \c ReportIncumbent() keeps a copy of the incumbent solution into \c incumbent_
+  bool keep_incumbent_ = false;
+
+  /// The last reported incumbent solution, when \c keep_incumbent_ is set
+  mutable std::vector<Solution> incumbent_;
   // double lambda_ =  0.0;  // read and write constant
 };  // end of class Algorithm
 
@@ -0,0 +1,381 @@
+/**
+ * \file src/solution/ant_colony_optimisation.cc
+ * \brief Contains the \c AntColonyOptimisation class methods.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This source file contains the methods from the \c AntColonyOptimisation class that run the ant
+ * colony optimisation.
+ */
+
+#include "src/solution/ant_colony_optimisation.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+DECLARE_uint64(number_of_threads);
+DECLARE_uint64(aco_number_of_ants);
+DECLARE_uint64(aco_number_of_generations);
+DECLARE_double(aco_alpha);
+DECLARE_double(aco_beta);
+DECLARE_double(aco_evaporation);
+DECLARE_string(aco_checkpoint_file);
+
+/// Ratio between the lower and the upper bounds of the trails
+static const double kMinimumPheromoneRatio = 0.01;
+
+/**
+ * \param[in]  weights    The non-negative weights; if all are zero, the first index is drawn
+ * \param[in]  generator  The random number generator of the thread
+ * \retval     index      The drawn index
+ */
+size_t AntColonyOptimisation::DrawIndex(const std::vector<double>& weights,
+                                        std::mt19937& generator) {
+  double total = 0.0;
+
+  for (double weight : weights) {
+    total += weight;
+  }
+
+  double threshold = std::generate_canonical<double, 32>(generator) * total;
+
+  for (size_t i = 0ul; i < weights.size(); ++i) {
+    threshold -= weights[i];
+
+    if (threshold < 0.0) {
+      return i;
+    }
+  }
+
+  // Rounding, or all the weights zero
+  for (size_t i = weights.size(); i > 0ul; --i) {
+    if (weights[i - 1ul] > 0.0) {
+      return i - 1ul;
+    }
+  }
+
+  return 0ul;
+}  // size_t AntColonyOptimisation::DrawIndex(...)
+
+/**
+ * Every candidate VM is probed with \c Solution::ScheduleTask() on a copy of the partial schedule.
+ * The increases of the objective value are normalised by the smallest one, so \f$ \eta \f$ is 1
+ * for the greedy choice. The output files are placed before the task is scheduled, so
+ * \c Solution::ScheduleTask() keeps them; a file that fits nowhere is left to its greedy placement.
+ *
+ * \param[in]  solution   An empty solution that receives the ant
+ * \param[in]  task_list  The tasks sorted by height
+ * \param[in]  generator  The random number generator of the thread
+ */
+void AntColonyOptimisation::ConstructAnt(Solution& solution,
+                                         const std::vector<Task*>& task_list,
+                                         std::mt19937& generator) {
+  const size_t number_of_vms = GetVirtualMachineSize();
+  const size_t number_of_storages = GetStorageSize();
+  std::vector<Task*> ready_tasks;
+  std::vector<double> increases;
+  std::vector<double> weights;
+  std::vector<size_t> storages;
+
+  AllocateStaticFiles(solution);
+
+  for (size_t level_begin = 0ul; level_begin < task_list.size();) {
+    size_t level_end = level_begin;
+
+    while (level_end < task_list.size()
+        && height_[task_list[level_end]->get_id()] == height_[task_list[level_begin]->get_id()]) {
+      ++level_end;
+    }
+
+    ready_tasks.assign(task_list.begin() + static_cast<long>(level_begin),
+                       task_list.begin() + static_cast<long>(level_end));
+    std::shuffle(ready_tasks.begin(), ready_tasks.end(), generator);
+
+    for (Task* task : ready_tasks) {
+      std::vector<VirtualMachine*> candidates = GetProbeCandidates(task, solution);
+      double base = solution.get_objective_value() == std::numeric_limits<double>::max()
+          ? 0.0 : solution.get_objective_value();
+      double minimal_increase = std::numeric_limits<double>::max();
+
+      increases.clear();
+
+      for (VirtualMachine* vm : candidates) {
+        Solution probe = solution;
+
+        increases.push_back(std::max(probe.ScheduleTask(task, vm) - base, 0.0));
+        minimal_increase = std::min(minimal_increase, increases.back());
+      }
+
+      weights.clear();
+
+      for (size_t i = 0ul; i < candidates.size(); ++i) {
+        double tau = task_pheromone_[task->get_id() * number_of_vms + candidates[i]->get_id()];
+        double eta = (minimal_increase + 1e-9) / (increases[i] + 1e-9);
+
+        weights.push_back(std::pow(tau, FLAGS_aco_alpha) * std::pow(eta, FLAGS_aco_beta));
+      }
+
+      VirtualMachine* vm = candidates[DrawIndex(weights, generator)];
+
+      for (File* file : task->get_output_files()) {
+        if (solution.GetFileAllocation(file->get_id()) != std::numeric_limits<size_t>::max()) {
+          continue;
+        }
+
+        storages.clear();
+        weights.clear();
+
+        for (size_t storage_id = 0ul; storage_id < number_of_storages; ++storage_id) {
+          if (solution.CanMoveFile(file->get_id(), storage_id)) {
+            Storage* storage = GetStoragePerId(storage_id);
+            double write_time = storage_id == vm->get_id() ? 1.0
+                : std::ceil(file->get_size_in_GB()
+                            / std::min(vm->get_bandwidth_GBps(), storage->get_bandwidth_GBps()));
+            double tau = file_pheromone_[file->get_id() * number_of_storages + storage_id];
+
+            storages.push_back(storage_id);
+            weights.push_back(std::pow(tau, FLAGS_aco_alpha)
+                              * std::pow(1.0 / write_time, FLAGS_aco_beta));
+          }
+        }
+
+        if (!storages.empty()) {
+          solution.SetFileAllocation(file->get_id(), storages[DrawIndex(weights, generator)]);
+        }
+      }
+
+      solution.ScheduleTask(task, vm);
+    }
+
+    level_begin = level_end;
+  }
+
+  solution.ObjectiveFunction(false, false);
+}  // void AntColonyOptimisation::ConstructAnt(...)
+
+/**
+ * \param[in]  best_objective_value  The objective value of the best solution so far
+ */
+void AntColonyOptimisation::SetPheromoneBounds(double best_objective_value) {
+  maximum_pheromone_ = 1.0 / (FLAGS_aco_evaporation * best_objective_value);
+  minimum_pheromone_ = kMinimumPheromoneRatio * maximum_pheromone_;
+}  // void AntColonyOptimisation::SetPheromoneBounds(double best_objective_value)
+
+/**
+ * The evaporation is one pass over each contiguous matrix, clamped to the lower bound; the
+ * deposit touches one trail per task and per stored file, clamped to the upper bound.
+ *
+ * \param[in]  solution  The ant that deposits
+ */
+void AntColonyOptimisation::UpdatePheromone(const Solution& solution) {
+  const double persistence = 1.0 - FLAGS_aco_evaporation;
+  const double minimum = minimum_pheromone_;
+  const double deposit = 1.0 / solution.get_objective_value();
+
+  for (double& tau : task_pheromone_) {
+    tau = std::max(tau * persistence, minimum);
+  }
+
+  for (double& tau : file_pheromone_) {
+    tau = std::max(tau * persistence, minimum);
+  }
+
+  for (size_t task_id = 0ul; task_id < GetTaskSize(); ++task_id) {
+    double& tau = task_pheromone_[task_id * GetVirtualMachineSize()
+                                  + solution.GetTaskAllocation(task_id)];
+
+    tau = std::min(tau + deposit, maximum_pheromone_);
+  }
+
+  for (size_t file_id = 0ul; file_id < GetFileSize(); ++file_id) {
+    if (solution.GetFileAllocation(file_id) != std::numeric_limits<size_t>::max()) {
+      double& tau = file_pheromone_[file_id * GetStorageSize()
+                                    + solution.GetFileAllocation(file_id)];
+
+      tau = std::min(tau + deposit, maximum_pheromone_);
+    }
+  }
+}  // void AntColonyOptimisation::UpdatePheromone(const Solution& solution)
+
+/**
+ * The file holds the numbers of tasks, VMs, files and storages, the bounds, and the two matrices;
+ * the numbers must match the instance.
+ *
+ * \param[in]  file_name  The checkpoint file
+ * \retval     read       True if the file exists and was read
+ */
+bool AntColonyOptimisation::ReadCheckpoint(const std::string& file_name) {
+  std::ifstream in_checkpoint(file_name);
+
+  if (!in_checkpoint.is_open()) {
+    return false;
+  }
+
+  size_t number_of_tasks, number_of_vms, number_of_files, number_of_storages;
+
+  in_checkpoint >> number_of_tasks >> number_of_vms >> number_of_files >> number_of_storages;
+
+  if (number_of_tasks != GetTaskSize() || number_of_vms != GetVirtualMachineSize()
+      || number_of_files != GetFileSize() || number_of_storages != GetStorageSize()) {
+    LOG(FATAL) << "The checkpoint " << file_name << " does not match the instance";
+  }
+
+  in_checkpoint >> maximum_pheromone_ >> minimum_pheromone_;
+
+  for (double& tau : task_pheromone_) {
+    in_checkpoint >> tau;
+  }
+
+  for (double& tau : file_pheromone_) {
+    in_checkpoint >> tau;
+  }
+
+  if (in_checkpoint.fail()) {
+    LOG(FATAL) << "Could not read the checkpoint " << file_name;
+  }
+
+  return true;
+}  // bool AntColonyOptimisation::ReadCheckpoint(const std::string& file_name)
+
+/**
+ * The trails are written to a temporary file that then replaces \c file_name, so an interrupted
+ * write never leaves a truncated checkpoint.
+ *
+ * \param[in]  file_name  The checkpoint file
+ */
+void AntColonyOptimisation::WriteCheckpoint(const std::string& file_name) const {
+  const std::string temporary_file_name = file_name + ".tmp";
+  std::ofstream out_checkpoint(temporary_file_name);
+
+  out_checkpoint << std::setprecision(17) << GetTaskSize() << " " << GetVirtualMachineSize() << " "
+      << GetFileSize() << " " << GetStorageSize() << std::endl
+      << maximum_pheromone_ << " " << minimum_pheromone_ << std::endl;
+
+  for (size_t i = 0ul; i < task_pheromone_.size(); ++i) {
+    out_checkpoint << task_pheromone_[i]
+        << ((i + 1ul) % GetVirtualMachineSize() == 0ul ? "\n" : " ");
+  }
+
+  for (size_t i = 0ul; i < file_pheromone_.size(); ++i) {
+    out_checkpoint << file_pheromone_[i] << ((i + 1ul) % GetStorageSize() == 0ul ? "\n" : " ");
+  }
+
+  out_checkpoint.close();
+
+  if (out_checkpoint.fail() || std::rename(temporary_file_name.c_str(), file_name.c_str()) != 0) {
+    LOG(FATAL) << "Could not write the checkpoint " << file_name;
+  }
+}  // void AntColonyOptimisation::WriteCheckpoint(const std::string& file_name) const
+
+/**
+ * The HEFT solution (see \c Algorithm::ConstructInitialSolution()) is the first best solution and
+ * sets the first bounds; without a checkpoint, all the trails start at the upper bound.
+ */
+void AntColonyOptimisation::Run() {
+  DLOG(INFO) << "Executing Ant Colony Optimisation...";
+
+  const size_t number_of_ants = FLAGS_aco_number_of_ants;
+  const size_t number_of_threads = std::max<size_t>(FLAGS_number_of_threads, 1ul);
+
+  if (number_of_ants == 0ul) {
+    LOG(FATAL) << "The colony needs at least one ant";
+  }
+
+  if (FLAGS_aco_evaporation <= 0.0 || FLAGS_aco_evaporation >= 1.0) {
+    LOG(FATAL) << "The evaporation must be in (0, 1): " << FLAGS_aco_evaporation;
+  }
+
+  // Order by height; the tasks of the same height are released together
+  std::vector<Task*> task_list(tasks_);
+
+  std::stable_sort(task_list.begin(), task_list.end(), [&](const Task* a, const Task* b) {
+    return height_[a->get_id()] < height_[b->get_id()];
+  });
+
+  Solution best_solution(this);
+
+  ConstructInitialSolution(best_solution);
+  ReportIncumbent(best_solution);
+
+  task_pheromone_.assign(GetTaskSize() * GetVirtualMachineSize(), 0.0);
+  file_pheromone_.assign(GetFileSize() * GetStorageSize(), 0.0);
+
+  if (FLAGS_aco_checkpoint_file.empty() || !ReadCheckpoint(FLAGS_aco_checkpoint_file)) {
+    SetPheromoneBounds(best_solution.get_objective_value());
+    std::fill(task_pheromone_.begin(), task_pheromone_.end(), maximum_pheromone_);
+    std::fill(file_pheromone_.begin(), file_pheromone_.end(), maximum_pheromone_);
+  } else {
+    std::cout << "Ant colony: resumed from " << FLAGS_aco_checkpoint_file << std::endl;
+  }
+
+  const Solution empty_solution(this);
+  std::vector<Solution> ants(number_of_ants, empty_solution);
+  std::vector<std::mt19937> generators;
+  size_t number_of_improvements = 0ul;
+  size_t generation = 0ul;
+
+  for (size_t t = 0ul; t < number_of_threads; ++t) {
+    generators.emplace_back(static_cast<std::mt19937::result_type>(rand()));
+  }
+
+  for (; generation < FLAGS_aco_number_of_generations && !IsTimeLimitReached(); ++generation) {
+    std::vector<std::thread> threads;
+    size_t thread_size = std::min(number_of_threads, number_of_ants);
+
+    auto construct = [&](size_t first) {
+      for (size_t i = first; i < number_of_ants; i += thread_size) {
+        ants[i] = empty_solution;
+        ConstructAnt(ants[i], task_list, generators[first]);
+      }
+    };
+
+    for (size_t t = 1ul; t < thread_size; ++t) {
+      threads.emplace_back(construct, t);
+    }
+
+    construct(0ul);
+
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    const Solution& generation_best = *std::min_element(
+        ants.begin(), ants.end(), [](const Solution& a, const Solution& b) {
+          return a.get_objective_value() < b.get_objective_value();
+        });
+
+    if (generation_best.get_objective_value() < best_solution.get_objective_value()) {
+      best_solution = generation_best;
+      ++number_of_improvements;
+      SetPheromoneBounds(best_solution.get_objective_value());
+      ReportIncumbent(best_solution);
+    }
+
+    UpdatePheromone(generation_best);
+
+    if (!FLAGS_aco_checkpoint_file.empty()) {
+      WriteCheckpoint(FLAGS_aco_checkpoint_file);
+    }
+  }
+
+  ReportSolution(best_solution);
+  std::cout << "Ant colony: " << generation << " generations of " << number_of_ants << " ants, "
+      << number_of_improvements << " improved the best solution" << std::endl;
+
+  DLOG(INFO) << "... ending Ant Colony Optimisation";
+}  // end of AntColonyOptimisation::Run() method
@@ -0,0 +1,84 @@
+/**
+ * \file src/solution/ant_colony_optimisation.h
+ * \brief Contains the \c AntColonyOptimisation class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This header file contains the \c AntColonyOptimisation class that builds schedules guided by
+ * pheromone trails over the task and file allocations.
+ */
+
+#ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_ANT_COLONY_OPTIMISATION_H_
+#define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_ANT_COLONY_OPTIMISATION_H_
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/solution/algorithm.h"
+
+/**
+ * \class AntColonyOptimisation ant_colony_optimisation.h "src/solution/ant_colony_optimisation.h"
+ * \brief MAX-MIN Ant System over the (task, VM) and (file, storage) allocations
+ *
+ * An ant schedules the tasks by height, in a random order inside each height, as the beam search
+ * does. The VM of a task is drawn with probability proportional to \f$ \tau^\alpha \eta^\beta \f$,
+ * where \f$ \eta \f$ is the inverse of the increase of the weighted objective when the task is
+ * scheduled there (see \c Solution::ScheduleTask()); then each output file is placed with the
+ * same rule, \f$ \eta \f$ being the inverse of its write time. The ants of a generation are built
+ * over \c --number_of_threads threads.
+ *
+ * After each generation the trails evaporate and the best ant of the generation deposits the
+ * inverse of its objective value; the trails are kept between \f$ \tau_{max} \f$, which follows the
+ * best solution, and a fraction of it. The trails are saved to \c --aco_checkpoint_file after each
+ * generation and read from it at the start, if it exists, so a long run can be resumed.
+ */
+class AntColonyOptimisation : public Algorithm {
+ public:
+  /// Default constructor
+  AntColonyOptimisation() = default;
+
+  /// Default destructor
+  ~AntColonyOptimisation() = default;
+
+  /// Build the colony generations; print the best solution
+  void Run(void);
+
+ private:
+  /// Build one ant into \c solution, with the random numbers of \c generator
+  void ConstructAnt(Solution& solution,
+                    const std::vector<Task*>& task_list,
+                    std::mt19937& generator);
+
+  /// Draw an index with probability proportional to \c weights
+  static size_t DrawIndex(const std::vector<double>& weights, std::mt19937& generator);
+
+  /// Evaporate all the trails and let \c solution deposit on its allocations
+  void UpdatePheromone(const Solution& solution);
+
+  /// Set \c maximum_pheromone_ and \c minimum_pheromone_ from the best objective value
+  void SetPheromoneBounds(double best_objective_value);
+
+  /// Read the trails from \c file_name; return false if the file does not exist
+  bool ReadCheckpoint(const std::string& file_name);
+
+  /// Write the trails to \c file_name
+  void WriteCheckpoint(const std::string& file_name) const;
+
+  /// Trail of each (task, VM), row-major by task
+  std::vector<double> task_pheromone_;
+
+  /// Trail of each (file, storage), row-major by file
+  std::vector<double> file_pheromone_;
+
+  /// Upper bound of the trails
+  double maximum_pheromone_ = 1.0;
+
+  /// Lower bound of the trails
+  double minimum_pheromone_ = 0.0;
+};  // end of class AntColonyOptimisation
+
+#endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_ANT_COLONY_OPTIMISATION_H_
@@ -0,0 +1,176 @@
+/**
+ * \file src/solution/beam_search_algorithm.cc
+ * \brief Contains the \c BeamSearchAlgorithm class methods.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This source file contains the methods from the \c BeamSearchAlgorithm class that run the beam
+ * search.
+ */
+
+#include "src/solution/beam_search_algorithm.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+DECLARE_uint64(beam_width);
+DECLARE_uint64(beam_expansion);
+DECLARE_uint64(number_of_threads);
+
+/**
+ * Probe every (ready task, candidate VM) pair and keep the \c expansion children with the smallest
+ * objective value, in increasing order. The children are moved, never copied, into the result.
+ *
+ * \param[in]  solution     The partial schedule to be expanded
+ * \param[in]  ready_tasks  The tasks that can be scheduled at this step
+ * \param[in]  expansion    The maximum number of children
+ * \retval     children     The best children of \c solution
+ */
+std::vector<Solution> BeamSearchAlgorithm::Expand(const Solution& solution,
+                                                  const std::vector<Task*>& ready_tasks,
+                                                  size_t expansion) {
+  std::vector<Solution> children;
+
+  children.reserve(expansion + 1ul);
+
+  for (Task* task : ready_tasks) {
+    if (solution.GetTaskAllocation(task->get_id()) != std::numeric_limits<size_t>::max()) {
+      continue;  // Already scheduled in this partial schedule
+    }
+
+    for (VirtualMachine* vm : GetProbeCandidates(task, solution)) {
+      Solution child = solution;
+
+      double objective_value = child.ScheduleTask(task, vm);
+
+      if (children.size() == expansion
+          && objective_value >= children.back().get_objective_value()) {
+        continue;
+      }
+
+      // Insertion into the sorted children; the list has at most expansion + 1 elements
+      auto position = std::upper_bound(children.begin(), children.end(), objective_value,
+                                       [](double value, const Solution& a) {
+                                         return value < a.get_objective_value();
+                                       });
+
+      children.insert(position, std::move(child));
+
+      if (children.size() > expansion) {
+        children.pop_back();
+      }
+    }
+  }
+
+  return children;
+}  // std::vector<Solution> BeamSearchAlgorithm::Expand(...)
+
+/**
+ * This method executes the algorithm
+ */
+void BeamSearchAlgorithm::Run() {
+  DLOG(INFO) << "Executing Beam Search algorithm...";
+
+  const size_t beam_width = std::max<size_t>(FLAGS_beam_width, 1ul);
+  const size_t number_of_threads = std::max<size_t>(FLAGS_number_of_threads, 1ul);
+  size_t expansion = std::max<size_t>(FLAGS_beam_expansion, 1ul);
+
+  // Order by height; the tasks of the same height are released together
+  std::vector<Task*> task_list(tasks_);
+
+  std::stable_sort(task_list.begin(), task_list.end(), [&](const Task* a, const Task* b) {
+    return height_[a->get_id()] < height_[b->get_id()];
+  });
+
+  Solution initial_solution(this);
+
+  AllocateStaticFiles(initial_solution);
+
+  std::vector<Solution> beam;
+
+  beam.push_back(std::move(initial_solution));
+
+  size_t level_begin = 0ul;
+
+  while (level_begin < task_list.size()) {
+    size_t level_end = level_begin;
+
+    while (level_end < task_list.size()
+        && height_[task_list[level_end]->get_id()] == height_[task_list[level_begin]->get_id()]) {
+      ++level_end;
+    }
+
+    std::vector<Task*> ready_tasks(task_list.begin() + static_cast<long>(level_begin),
+                                   task_list.begin() + static_cast<long>(level_end));
+
+    // Each step schedules one more task in all the partial schedules
+    for (size_t step = level_begin; step < level_end; ++step) {
+      // On the deadline, finish the schedule greedily with the best partial schedule
+      if (beam.size() > 1ul && IsTimeLimitReached()) {
+        DLOG(INFO) << "Time limit reached; finishing greedily";
+        beam.erase(beam.begin() + 1, beam.end());
+        expansion = 1ul;
+      }
+
+      std::vector<std::vector<Solution>> children(beam.size());
+      std::vector<std::thread> threads;
+      size_t thread_size = std::min(number_of_threads, beam.size());
+
+      auto expand = [&](size_t first) {
+        for (size_t i = first; i < beam.size(); i += thread_size) {
+          children[i] = Expand(beam[i], ready_tasks, expansion);
+        }
+      };
+
+      for (size_t t = 1ul; t < thread_size; ++t) {
+        threads.emplace_back(expand, t);
+      }
+
+      expand(0ul);
+
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+
+      std::vector<Solution> pool;
+
+      for (std::vector<Solution>& partial_children : children) {
+        for (Solution& child : partial_children) {
+          pool.push_back(std::move(child));
+        }
+      }
+
+      size_t next_size = std::min(beam_width, pool.size());
+
+      std::partial_sort(pool.begin(), pool.begin() + static_cast<long>(next_size), pool.end(),
+                        [](const Solution& a, const Solution& b) {
+                          return a.get_objective_value() < b.get_objective_value();
+                        });
+
+      pool.erase(pool.begin() + static_cast<long>(next_size), pool.end());
+      std::swap(beam, pool);
+    }
+
+    level_begin = level_end;
+  }
+
+  DLOG(INFO) << "Scheduling done";
+
+  Solution& best_solution = beam.front();
+
+  best_solution.ObjectiveFunction(false, false);
+
+  ReportIncumbent(best_solution);
+  ReportSolution(best_solution);
+
+  DLOG(INFO) << "... ending Beam Search algorithm";
+}  // end of BeamSearchAlgorithm::Run() method
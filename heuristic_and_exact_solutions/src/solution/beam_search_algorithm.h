@@ -0,0 +1,47 @@
+/**
+ * \file src/solution/beam_search_algorithm.h
+ * \brief Contains the \c BeamSearchAlgorithm class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This header file contains the \c BeamSearchAlgorithm class that builds the schedule keeping
+ * several partial solutions at each step.
+ */
+
+#ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_BEAM_SEARCH_ALGORITHM_H_
+#define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_BEAM_SEARCH_ALGORITHM_H_
+
+#include <vector>
+#include "src/solution/algorithm.h"
+
+/**
+ * \class BeamSearchAlgorithm beam_search_algorithm.h "src/solution/beam_search_algorithm.h"
+ * \brief Keeps the best \c --beam_width partial schedules of the ready-list process
+ *
+ * The tasks are released by height, as in the Min-Min algorithm. At each step, every partial
+ * schedule of the beam is expanded with its \c --beam_expansion best (task, VM) moves, and the
+ * best \c --beam_width children form the next beam. The partial schedules are expanded in
+ * parallel by \c --number_of_threads threads.
+ */
+class BeamSearchAlgorithm : public Algorithm {
+ public:
+  /// Default constructor
+  BeamSearchAlgorithm() = default;
+
+  /// Default destructor
+  ~BeamSearchAlgorithm() = default;
+
+  /// Create variables; run the beam over the ready tasks; print the best solution
+  void Run(void);
+
+ private:
+  /// Return the best \c expansion children of \c solution, scheduling one of the \c ready_tasks
+  std::vector<Solution> Expand(const Solution& solution,
+                               const std::vector<Task*>& ready_tasks,
+                               size_t expansion);
+};  // end of class BeamSearchAlgorithm
+
+#endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_BEAM_SEARCH_ALGORITHM_H_
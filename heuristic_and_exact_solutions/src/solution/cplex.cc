@@ -36,6 +36,7 @@
 #include "src/model/static_file.h"
 
 DECLARE_string(cplex_output_file);
+DECLARE_double(time_limit_seconds);
 
 // #define PRECISAO 0.00001
 
@@ -687,10 +688,10 @@ ILOINCUMBENTCALLBACK2(CB_incub_sol, struct BEST*, data, struct CPLEX*, cplx)
   double                         val_sol = (double) getObjValue();
   IloCplex::MIPCallbackI::NodeId no_sol  = getNodeId();
   double                         gap     = 100.0 * ((double) getMIPRelativeGap());
-  double                         time_f  = ((double) clock() - (double)data->start) / CLOCKS_PER_SEC;
   bool                           DEPU    = true;
 
   Algorithm* algorithm = data->algorithm_;
+  double                         time_f  = algorithm->GetElapsedTime();
 
   if (DEPU)
   {
@@ -855,6 +856,53 @@ ILOINCUMBENTCALLBACK2(CB_incub_sol, struct BEST*, data, struct CPLEX*, cplx)
 
     // -------- z_max ----------
     data->z_max = (float) getValue(cplx->z_max[0]);
+
+    // -------- linha do incumbente ----------
+    double custo     = 0.0;
+    double seguranca = 0.0;
+
+    for (int j = 0; j < data->m_; ++j)
+    {
+      custo += algorithm->GetVirtualMachinePerId(static_cast<size_t>(j))->get_cost() * data->z[j];
+    }
+
+    for (int b = 0; b < data->numb_; ++b)
+    {
+      Storage* storage = algorithm->GetStoragePerId(algorithm->GetVirtualMachineSize()
+                                                    + static_cast<size_t>(b));
+
+      if (Bucket* bucket = dynamic_cast<Bucket*>(storage))
+      {
+        for (int l = 0; l <= static_cast<int>(bucket->get_number_of_GB_per_cost_intervals()); l++)
+        {
+          custo += bucket->get_cost() * getValue(cplx->q[b][l]);
+        }
+      }
+    }
+
+    for (int r = 0; r < data->numr_; ++r)
+    {
+      for (int i = 0; i < data->n_; ++i)
+      {
+        seguranca += getValue(cplx->e[r][i]);
+      }
+    }
+
+    for (int d1 = 0; d1 < data->d_ - 1; ++d1)
+    {
+      for (int d2 = d1 + 1; d2 < data->d_; ++d2)
+      {
+        int conflict = algorithm->get_conflict_graph().ReturnConflict(static_cast<size_t>(d1),
+                                                                      static_cast<size_t>(d2));
+
+        if (conflict > 0)
+        {
+          seguranca += conflict * getValue(cplx->ws[d1][d2]);
+        }
+      }
+    }
+
+    algorithm->ReportIncumbent(val_sol, data->z_max, custo, seguranca);
   }
 }
 
@@ -2258,12 +2306,64 @@ void Cplex::Run() {
     }
   }
 
+  // Quebra de simetria
+  // Maquinas da mesma classe (ver Algorithm::ComputeVirtualMachineClasses) e sem arquivos estaticos
+  // sao intercambiaveis; a carga (numero de tarefas) da primeira deve ser maior ou igual a da
+  // proxima maquina da mesma classe
+  {
+    std::vector<bool> has_static_file(static_cast<size_t>(_m), false);
+
+    for (File* file : files_)
+    {
+      if (StaticFile* static_file = dynamic_cast<StaticFile*>(file))
+      {
+        if (static_file->GetFirstVm() < static_cast<size_t>(_m))
+          has_static_file[static_file->GetFirstVm()] = true;
+      }
+    }
+
+    std::vector<int> last_of_class(get_number_of_virtual_machine_classes(), -1);
+
+    for (int j = 0; j < _m; j++)
+    {
+      if (has_static_file[static_cast<size_t>(j)])
+        continue;
+
+      size_t class_id = GetVirtualMachineClass(static_cast<size_t>(j));
+      int    k        = last_of_class[class_id];
+
+      last_of_class[class_id] = j;
+
+      if (k < 0)
+        continue;
+
+      IloExpr exp(cplx.env);
+
+      for (int i = 0; i < _n; i++)
+      {
+        for (int t = 0; t < _t; t++)
+        {
+          exp += cplx.x[i][k][t];
+          exp -= cplx.x[i][j][t];
+        }
+      }
+
+      IloConstraint c(exp >= 0);
+
+      sprintf (var_name, "csym_%d_%d", (int) k, (int) j);
+      c.setName(var_name);
+      cplx.model.add(c);
+
+      exp.end();
+    }
+  }
+
   IloCplex solver(cplx.model);                          // declara variável "solver" sobre o modelo a ser solucionado
   // solver.exportModel("model.lp");                       // escreve modelo no arquivo no formato .lp
   solver.exportModel(FLAGS_cplex_output_file.c_str());  // escreve modelo no arquivo no formato .lp
 
   // Parametros
-  solver.setParam(IloCplex::TiLim, 3600);            // tempo limite (3600=1h, 86400=1d)
+  solver.setParam(IloCplex::TiLim, GetRemainingTime());  // tempo limite (--time_limit_seconds)
   solver.setParam(IloCplex::MIPInterval, 100);       // Log a cada N nos
 
   // -------------------- Callbacks ----------------------
@@ -2298,7 +2398,7 @@ void Cplex::Run() {
 
     res    = solver.getObjValue ();                                    // solução
     lb     = solver.getBestObjValue();                                 // limite dual (inferior)
-    time_s = ((double) clock() - (double) t_start) / CLOCKS_PER_SEC;    // tempo de processamento
+    time_s = GetElapsedTime();                                         // tempo de processamento
 
     double custo = 0.0;
     double seguranca = 0.0;
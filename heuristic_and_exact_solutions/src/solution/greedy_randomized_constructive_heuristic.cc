@@ -16,7 +16,10 @@
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
+#include <boost/algorithm/string.hpp>
+
 #include <list>
+#include <string>
 #include <vector>
 #include <limits>
 #include <cmath>
@@ -26,8 +29,14 @@
 
 #include "src/model/static_file.h"
 #include "src/model/storage.h"
+#include "src/solution/local_search.h"
 
 DECLARE_uint64(number_of_iteration);
+DECLARE_string(reactive_alphas);
+DECLARE_uint64(reactive_update_period);
+DECLARE_string(path_relinking);
+DECLARE_uint64(path_relinking_period);
+DECLARE_uint64(elite_pool_size);
 
 // std::random_device rd_chr;
 // std::mt19937 engine_chr(rd_chr());
@@ -57,7 +66,7 @@ void GreedyRandomizedConstructiveHeuristic::ScheduleAvailTasks(std::list<Task*>
       double task_minimal_objective_value = std::numeric_limits<double>::max();
       size_t min_vm_id = 0;
 
-      for (VirtualMachine* vm : virtual_machines_) {
+      for (VirtualMachine* vm : GetProbeCandidates(task, solution)) {
         Solution new_solution = solution;
 
         double objective_value = new_solution.ScheduleTask(task, vm);
@@ -123,6 +132,210 @@ void GreedyRandomizedConstructiveHeuristic::ScheduleAvailTasks(std::list<Task*>
   }  // while (!avail_tasks.empty()) {
 }  // void GreedyRandomizedConstructiveHeuristic::schedule(...)
 
+/**
+ * Parse the comma separated values of \c --reactive_alphas; each one must be a number in [0, 1]
+ * (see \c ParseNumber()). All the alphas start with the same probability.
+ */
+void GreedyRandomizedConstructiveHeuristic::ReadReactiveAlphas() {
+  std::vector<std::string> tokens;
+
+  reactive_alphas_.clear();
+
+  if (FLAGS_reactive_alphas.empty()) {
+    return;
+  }
+
+  if (FLAGS_reactive_update_period == 0ul) {
+    LOG(FATAL) << "The reactive update period must be positive";
+  }
+
+  boost::split(tokens, FLAGS_reactive_alphas, boost::is_any_of(","));
+
+  for (const std::string& token : tokens) {
+    double alpha;
+
+    if (!ParseNumber(token, alpha) || alpha < 0.0 || alpha > 1.0) {
+      LOG(FATAL) << "Invalid reactive alpha \"" << token << "\"; expected a number in [0, 1]";
+    }
+
+    reactive_alphas_.push_back(alpha);
+  }
+
+  double probability = 1.0 / static_cast<double>(reactive_alphas_.size());
+
+  alpha_probabilities_.assign(reactive_alphas_.size(), probability);
+  alpha_objective_sum_.assign(reactive_alphas_.size(), 0.0);
+  alpha_count_.assign(reactive_alphas_.size(), 0ul);
+}  // void GreedyRandomizedConstructiveHeuristic::ReadReactiveAlphas()
+
+/**
+ * Roulette-wheel selection over \c alpha_probabilities_
+ *
+ * \retval  alpha_index  The index of the selected alpha in \c reactive_alphas_
+ */
+size_t GreedyRandomizedConstructiveHeuristic::SelectAlpha() {
+  double roulette = static_cast<double>(rand()) / static_cast<double>(RAND_MAX);
+
+  for (size_t i = 0ul; i < alpha_probabilities_.size(); ++i) {
+    roulette -= alpha_probabilities_[i];
+
+    if (roulette <= 0.0) {
+      return i;
+    }
+  }
+
+  return alpha_probabilities_.size() - 1ul;
+}  // size_t GreedyRandomizedConstructiveHeuristic::SelectAlpha()
+
+/**
+ * Reactive GRASP update. With \f$ A_i \f$ the average objective value of the solutions built
+ * with the alpha \f$ i \f$ and \f$ z^* \f$ the best objective value found so far:
+ *
+ *   \f[
+ *      q_i = (z^* / A_i)^{\delta}, \quad p_i = q_i / \sum_j q_j
+ *   \f]
+ *
+ * An alpha that was never drawn keeps \f$ q_i = 1 \f$, the largest possible value, so it is still
+ * explored; so does an alpha whose average is 0, which is then the best one. The exponent
+ * \f$ \delta = 10 \f$ sharpens the difference between the alphas. If the sum of the \f$ q_i \f$
+ * is not a positive finite number, the probabilities are uniform again.
+ *
+ * \param[in]  best_objective_value  The objective value of the best solution so far
+ */
+void GreedyRandomizedConstructiveHeuristic::UpdateAlphaProbabilities(
+    double best_objective_value) {
+  const double delta = 10.0;
+  double sum = 0.0;
+
+  for (size_t i = 0ul; i < reactive_alphas_.size(); ++i) {
+    double q = 1.0;
+
+    if (alpha_count_[i] > 0ul) {
+      double average = alpha_objective_sum_[i] / static_cast<double>(alpha_count_[i]);
+
+      if (average != 0.0) {
+        q = std::pow(best_objective_value / average, delta);
+      }
+    }
+
+    alpha_probabilities_[i] = q;
+    sum += q;
+  }
+
+  if (!std::isfinite(sum) || sum <= 0.0) {
+    alpha_probabilities_.assign(reactive_alphas_.size(), 1.0);
+    sum = static_cast<double>(reactive_alphas_.size());
+  }
+
+  for (size_t i = 0ul; i < reactive_alphas_.size(); ++i) {
+    alpha_probabilities_[i] /= sum;
+    DLOG(INFO) << "Probability of alpha " << reactive_alphas_[i] << ": " << alpha_probabilities_[i];
+  }
+}  // void GreedyRandomizedConstructiveHeuristic::UpdateAlphaProbabilities(...)
+
+/**
+ * A solution equal to an elite one, in the sense of \c Algorithm::ComputeDistance(), is rejected.
+ * While the pool is not full, any other solution enters it. Afterwards, a solution better than the
+ * worst elite one replaces, among the elite solutions worse than it, the most similar one; so the
+ * pool keeps improving without collapsing into a single region.
+ *
+ * \param[in]  solution  An evaluated complete solution
+ */
+void GreedyRandomizedConstructiveHeuristic::UpdateElitePool(const Solution& solution) {
+  size_t worst = 0ul;
+
+  for (size_t i = 0ul; i < elite_pool_.size(); ++i) {
+    if (ComputeDistance(solution, elite_pool_[i]) == 0ul) {
+      return;
+    }
+
+    if (elite_pool_[i].get_objective_value() > elite_pool_[worst].get_objective_value()) {
+      worst = i;
+    }
+  }
+
+  if (elite_pool_.size() < FLAGS_elite_pool_size) {
+    elite_pool_.push_back(solution);
+    return;
+  }
+
+  if (elite_pool_.empty()
+      || solution.get_objective_value() >= elite_pool_[worst].get_objective_value()) {
+    return;
+  }
+
+  size_t replaced = worst;
+  size_t minimal_distance = std::numeric_limits<size_t>::max();
+
+  for (size_t i = 0ul; i < elite_pool_.size(); ++i) {
+    if (elite_pool_[i].get_objective_value() > solution.get_objective_value()) {
+      size_t distance = ComputeDistance(solution, elite_pool_[i]);
+
+      if (distance < minimal_distance) {
+        minimal_distance = distance;
+        replaced = i;
+      }
+    }
+  }
+
+  elite_pool_[replaced] = solution;
+}  // void GreedyRandomizedConstructiveHeuristic::UpdateElitePool(const Solution& solution)
+
+/**
+ * Each path starts at the better solution of the pair and is guided by the worse one, so the walk
+ * explores around the better one (see \c LocalSearch::PathRelinking()). The best intermediate
+ * solutions are offered to the elite pool once all the paths are walked.
+ *
+ * \param[in]  best_solution  The best solution so far; replaced by a better relinked one
+ * \param[in]  local_search   The local search that walks the paths
+ * \param[in]  all_pairs      Relink all the pairs, or only the best elite with each other one
+ */
+void GreedyRandomizedConstructiveHeuristic::RelinkElitePool(Solution& best_solution,
+                                                            LocalSearch& local_search,
+                                                            bool all_pairs) {
+  std::vector<Solution> relinked_solutions;
+  size_t best = 0ul;
+
+  for (size_t i = 0ul; i < elite_pool_.size(); ++i) {
+    if (elite_pool_[i].get_objective_value() < elite_pool_[best].get_objective_value()) {
+      best = i;
+    }
+  }
+
+  for (size_t i = 0ul; i < elite_pool_.size(); ++i) {
+    for (size_t j = i + 1ul; j < elite_pool_.size(); ++j) {
+      if (!all_pairs && i != best && j != best) {
+        continue;
+      }
+
+      if (IsTimeLimitReached()) {
+        break;
+      }
+
+      const Solution& initial = elite_pool_[i].get_objective_value()
+          <= elite_pool_[j].get_objective_value() ? elite_pool_[i] : elite_pool_[j];
+      const Solution& guiding = &initial == &elite_pool_[i] ? elite_pool_[j] : elite_pool_[i];
+      Solution relinked = initial;
+
+      if (local_search.PathRelinking(initial, guiding, relinked)) {
+        ++number_of_relinkings_;
+
+        if (relinked.get_objective_value() < best_solution.get_objective_value()) {
+          ++number_of_relinking_improvements_;
+          best_solution = relinked;
+          ReportIncumbent(best_solution);
+        }
+
+        relinked_solutions.push_back(relinked);
+      }
+    }
+  }
+
+  for (const Solution& relinked : relinked_solutions) {
+    UpdateElitePool(relinked);
+  }
+}  // void GreedyRandomizedConstructiveHeuristic::RelinkElitePool(...)
+
 void GreedyRandomizedConstructiveHeuristic::Run() {
   DLOG(INFO) << "Executing Greedy Randomized Constructive Heuristic ...";
   // google::FlushLogFiles(google::INFO);
@@ -130,10 +343,52 @@ void GreedyRandomizedConstructiveHeuristic::Run() {
   // std::srand(unsigned(std::time(0)));
 
   Solution best_solution(this);
+  LocalSearch local_search(this);
+
+  ReadReactiveAlphas();
+
+  elite_pool_.clear();
+  number_of_relinkings_ = 0ul;
+  number_of_relinking_improvements_ = 0ul;
+
+  if (FLAGS_path_relinking != "none" && FLAGS_path_relinking != "post"
+      && FLAGS_path_relinking != "interleaved") {
+    LOG(FATAL) << "Invalid path relinking: " << FLAGS_path_relinking;
+  }
+
+  if (FLAGS_path_relinking == "interleaved" && FLAGS_path_relinking_period == 0ul) {
+    LOG(FATAL) << "The path relinking period must be positive";
+  }
+
+  // The warm starts of a silent run, as the immigrants of an island, join the best and the elite
+  for (Solution& warm_start : warm_starts_) {
+    warm_start.ObjectiveFunction(false, false);
+
+    if (best_solution.get_objective_value() > warm_start.get_objective_value()) {
+      best_solution = warm_start;
+      ReportIncumbent(best_solution);
+    }
+
+    if (FLAGS_path_relinking != "none") {
+      UpdateElitePool(warm_start);
+    }
+  }
 
   for (size_t i = 0; i < FLAGS_number_of_iteration; ++i) {
+    if (i > 0 && IsTimeLimitReached()) {
+      DLOG(INFO) << "Time limit reached after " << i << " iterations";
+      break;
+    }
+
     std::list<Task*> task_list;
     std::list<Task*> avail_tasks;
+    size_t alpha_index = 0ul;
+
+    // Reactive mode; the restrict candidate list threshold is drawn for each iteration
+    if (!reactive_alphas_.empty()) {
+      alpha_index = SelectAlpha();
+      alpha_restrict_candidate_list_ = reactive_alphas_[alpha_index];
+    }
 
     Solution solution(this);
 
@@ -181,13 +436,42 @@ void GreedyRandomizedConstructiveHeuristic::Run() {
 
     // solution.ObjectiveFunction(false, false);
 
+    if (local_search.is_enabled()) {
+      local_search.VariableNeighbourhoodDescent(solution);
+    } else if (FLAGS_path_relinking != "none") {
+      // The relinking steps are evaluated by simulation, so are the elite solutions
+      solution.ObjectiveFunction(false, false);
+    }
+
     if (best_solution.get_objective_value() > solution.get_objective_value()) {
       best_solution = solution;
+      ReportIncumbent(best_solution);
+    }
+
+    if (!reactive_alphas_.empty()) {
+      alpha_objective_sum_[alpha_index] += solution.get_objective_value();
+      ++alpha_count_[alpha_index];
+
+      if ((i + 1) % FLAGS_reactive_update_period == 0) {
+        UpdateAlphaProbabilities(best_solution.get_objective_value());
+      }
+    }
+
+    if (FLAGS_path_relinking != "none") {
+      UpdateElitePool(solution);
+
+      if (FLAGS_path_relinking == "interleaved" && (i + 1) % FLAGS_path_relinking_period == 0) {
+        RelinkElitePool(best_solution, local_search, false);
+      }
     }
 
     LOG(INFO) << solution;
   }  // for (size_t i = 0; i < FLAGS_number_of_iteration; ++i) {
 
+  if (FLAGS_path_relinking == "post") {
+    RelinkElitePool(best_solution, local_search, true);
+  }
+
   // std::cout << best_solution << std::endl;
 
   // best_solution.ObjectiveFunction(false, false);
@@ -198,6 +482,21 @@ void GreedyRandomizedConstructiveHeuristic::Run() {
   // best_solution.ObjectiveFunction(false, false);
   std::cout << best_solution;
 
+  local_search.ReportStatistics();
+
+  if (FLAGS_path_relinking != "none") {
+    std::cout << "Path relinking: " << number_of_relinking_improvements_ << " of "
+        << number_of_relinkings_ << " paths improved the best solution" << std::endl;
+  }
+
+  if (!reactive_alphas_.empty()) {
+    std::cout << "Reactive alpha probabilities:";
+    for (size_t i = 0ul; i < reactive_alphas_.size(); ++i) {
+      std::cout << " " << reactive_alphas_[i] << ":" << alpha_probabilities_[i];
+    }
+    std::cout << std::endl;
+  }
+
   // std::cout << best_solution.get_makespan()
   //     << " " << best_solution.get_cost()
   //     << " " << best_solution.get_security_exposure()
@@ -205,7 +504,7 @@ void GreedyRandomizedConstructiveHeuristic::Run() {
 
   double time_s;
 
-  time_s = ((double) clock() - (double) t_start) / CLOCKS_PER_SEC;    // tempo de processamento
+  time_s = GetElapsedTime();    // tempo de processamento
 
   std::cerr << best_solution.get_makespan()
       << " " << best_solution.get_cost()
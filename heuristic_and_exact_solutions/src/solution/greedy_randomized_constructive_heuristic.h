@@ -14,7 +14,9 @@
 #ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_GREEDY_ALGORITHM_H_
 #define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_GREEDY_ALGORITHM_H_
 
+#include <vector>
 #include "src/solution/algorithm.h"
+#include "src/solution/local_search.h"
 
 class GreedyRandomizedConstructiveHeuristic : public Algorithm {
  public:
@@ -31,6 +33,41 @@ class GreedyRandomizedConstructiveHeuristic : public Algorithm {
   void Run(void);
 
  private:
+  /// Read the alpha values of the reactive mode from \c --reactive_alphas
+  void ReadReactiveAlphas();
+
+  /// Draw the index of the alpha used in the next iteration according to \c alpha_probabilities_
+  size_t SelectAlpha();
+
+  /// Recompute \c alpha_probabilities_ from the average objective value of each alpha
+  void UpdateAlphaProbabilities(double best_objective_value);
+
+  /// Insert the evaluated \c solution into \c elite_pool_ if it is good and diverse enough
+  void UpdateElitePool(const Solution& solution);
+
+  /// Relink the pairs of \c elite_pool_; update \c best_solution; all pairs or the best with each
+  void RelinkElitePool(Solution& best_solution, LocalSearch& local_search, bool all_pairs);
+
+  /// Alpha values of the reactive mode; empty when the mode is off
+  std::vector<double> reactive_alphas_;
+
+  /// Selection probability of each alpha
+  std::vector<double> alpha_probabilities_;
+
+  /// Accumulated objective value of the solutions built with each alpha
+  std::vector<double> alpha_objective_sum_;
+
+  /// Number of solutions built with each alpha
+  std::vector<size_t> alpha_count_;
+
+  /// Best and pairwise different solutions, for the path relinking
+  std::vector<Solution> elite_pool_;
+
+  /// Number of paths with an intermediate solution
+  size_t number_of_relinkings_ = 0ul;
+
+  /// Number of paths that gave a new best solution
+  size_t number_of_relinking_improvements_ = 0ul;
 };  // end of class GreedyAlgorithm
 
 #endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_GREEDY_ALGORITHM_H_
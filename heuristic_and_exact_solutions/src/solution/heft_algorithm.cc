@@ -0,0 +1,42 @@
+/**
+ * \file src/solution/heft_algorithm.cc
+ * \brief Contains the \c HeftAlgorithm class methods.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This source file contains the methods from the \c HeftAlgorithm class that run the HEFT list
+ * scheduling.
+ */
+
+#include "src/solution/heft_algorithm.h"
+
+#include <glog/logging.h>
+
+/**
+ * This method executes the algorithm
+ */
+void HeftAlgorithm::Run() {
+  DLOG(INFO) << "Executing HEFT algorithm...";
+
+  Solution solution(this);
+
+  ConstructGreedySolution(solution);
+
+  ReportIncumbent(solution);
+
+  LOG(INFO) << solution;
+  std::cout << solution;
+
+  double time_s = GetElapsedTime();
+
+  std::cerr << solution.get_makespan()
+      << " " << solution.get_cost()
+      << " " << solution.get_security_exposure() / get_maximum_security_and_privacy_exposure()
+      << " " << solution.get_objective_value() << std::endl
+      << time_s << std::endl;
+
+  DLOG(INFO) << "... ending HEFT algorithm";
+}  // end of HeftAlgorithm::Run() method
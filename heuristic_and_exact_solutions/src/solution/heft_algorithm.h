@@ -0,0 +1,38 @@
+/**
+ * \file src/solution/heft_algorithm.h
+ * \brief Contains the \c HeftAlgorithm class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This header file contains the \c HeftAlgorithm class that schedules the tasks following the
+ * Heterogeneous Earliest Finish Time (HEFT) list scheduling.
+ */
+
+#ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_HEFT_ALGORITHM_H_
+#define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_HEFT_ALGORITHM_H_
+
+#include "src/solution/algorithm.h"
+
+/**
+ * \class HeftAlgorithm heft_algorithm.h "src/solution/heft_algorithm.h"
+ * \brief Schedules the tasks in decreasing order of upward rank
+ *
+ * Each task is inserted once, at the Virtual Machine that minimises the weighted objective of the
+ * partial solution, so the whole schedule is built with O(T.V) probes.
+ */
+class HeftAlgorithm : public Algorithm {
+ public:
+  /// Default constructor
+  HeftAlgorithm() = default;
+
+  /// Default destructor
+  ~HeftAlgorithm() = default;
+
+  /// Create variables; schedule tasks in upward rank order; print solution
+  void Run(void);
+};  // end of class HeftAlgorithm
+
+#endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_HEFT_ALGORITHM_H_
@@ -0,0 +1,447 @@
+/**
+ * \file src/solution/island_model.cc
+ * \brief Contains the \c IslandModel class methods.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This source file contains the methods from the \c IslandModel class that run the islands and
+ * migrate the solutions between them.
+ */
+
+#include "src/solution/island_model.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef WF_SECURITY_MPI
+#include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+DECLARE_string(tasks_and_files);
+DECLARE_string(cluster);
+DECLARE_string(conflict_graph);
+DECLARE_uint64(number_of_islands);
+DECLARE_string(island_engine);
+DECLARE_uint64(island_epochs);
+DECLARE_uint64(migration_size);
+
+/**
+ * Kill the forked islands from \c children[first] on and reap them. A failed island stops the run,
+ * and the others would otherwise go on as orphans attached to the shared mapping.
+ *
+ * \param[in]  children  The process ids of the forked islands
+ * \param[in]  first     The first island still running
+ */
+static void StopIslands(const std::vector<pid_t>& children, size_t first) {
+  for (size_t island = first; island < children.size(); ++island) {
+    kill(children[island], SIGKILL);
+  }
+
+  for (size_t island = first; island < children.size(); ++island) {
+    waitpid(children[island], nullptr, 0);
+  }
+}  // static void StopIslands(const std::vector<pid_t>& children, size_t first)
+
+/**
+ * The ring buffers start at a cache line each, with the message counter, followed by their slots.
+ *
+ * \param[in]  island  The island, or the number of islands for the results
+ * \retval     head    The number of messages written into the ring buffer of \c island
+ */
+std::atomic<uint64_t>* IslandModel::GetHead(size_t island) {
+  return reinterpret_cast<std::atomic<uint64_t>*>(
+      shared_memory_ + island * (64ul + ring_capacity_ * slot_size_));
+}  // std::atomic<uint64_t>* IslandModel::GetHead(size_t island)
+
+/**
+ * \param[in]  island  The island, or the number of islands for the results
+ * \param[in]  index   The slot of the ring buffer, or the island of the result
+ * \retval     slot    The slot, followed by its encoded solution
+ */
+IslandModel::Slot* IslandModel::GetSlot(size_t island, size_t index) {
+  return reinterpret_cast<Slot*>(reinterpret_cast<char*>(GetHead(island)) + 64ul
+                                 + index * slot_size_);
+}  // IslandModel::Slot* IslandModel::GetSlot(size_t island, size_t index)
+
+/**
+ * The forked islands decide alone; the MPI islands stop together, so their messages match.
+ *
+ * \param[in]  stop  Whether this island must stop
+ * \retval     stop  Whether the islands stop
+ */
+bool IslandModel::AgreeToStop(bool stop) {
+#ifdef WF_SECURITY_MPI
+  if (use_mpi_) {
+    int local_stop = stop ? 1 : 0;
+    int global_stop = 0;
+
+    MPI_Allreduce(&local_stop, &global_stop, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD);
+
+    return global_stop != 0;
+  }
+#endif
+
+  return stop;
+}  // bool IslandModel::AgreeToStop(bool stop)
+
+/**
+ * Between forked islands, the \c emigrants are written into the ring buffer of the \c island
+ * and the messages of the previous island not read yet are taken from its ring buffer; those
+ * overwritten in the meantime are lost. A slot is valid when its sequence is even and the same
+ * before and after the copy of its encoding, as in a sequence lock.
+ *
+ * Between MPI islands, the \c emigrants are sent, preceded by their number, in one message.
+ *
+ * \param[in]  island      The island sending the \c emigrants
+ * \param[in]  emigrants   The encoded solutions sent to the next island
+ * \retval     immigrants  The encoded solutions received from the previous island
+ */
+std::vector<std::vector<uint32_t>> IslandModel::Migrate(
+    size_t island,
+    const std::vector<std::vector<uint32_t>>& emigrants) {
+  std::vector<std::vector<uint32_t>> immigrants;
+  size_t previous = (island + number_of_islands_ - 1ul) % number_of_islands_;
+
+  if (number_of_islands_ == 1ul) {
+    return immigrants;
+  }
+
+#ifdef WF_SECURITY_MPI
+  if (use_mpi_) {
+    std::vector<uint32_t> sent(1ul + emigrants.size() * encoding_size_);
+    std::vector<uint32_t> received(1ul + FLAGS_migration_size * encoding_size_);
+
+    sent[0] = static_cast<uint32_t>(emigrants.size());
+
+    for (size_t i = 0ul; i < emigrants.size(); ++i) {
+      std::copy(emigrants[i].begin(), emigrants[i].end(), sent.begin()
+                + static_cast<std::ptrdiff_t>(1ul + i * encoding_size_));
+    }
+
+    MPI_Sendrecv(sent.data(), static_cast<int>(sent.size()), MPI_UINT32_T,
+                 static_cast<int>((island + 1ul) % number_of_islands_), 0,
+                 received.data(), static_cast<int>(received.size()), MPI_UINT32_T,
+                 static_cast<int>(previous), 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+    for (size_t i = 0ul; i < received[0]; ++i) {
+      auto begin = received.begin() + static_cast<std::ptrdiff_t>(1ul + i * encoding_size_);
+
+      immigrants.emplace_back(begin, begin + static_cast<std::ptrdiff_t>(encoding_size_));
+    }
+
+    return immigrants;
+  }
+#endif
+
+  // Only this island writes into its ring buffer
+  std::atomic<uint64_t>* head = GetHead(island);
+  uint64_t message = head->load(std::memory_order_relaxed);
+
+  for (const std::vector<uint32_t>& emigrant : emigrants) {
+    Slot* slot = GetSlot(island, message % ring_capacity_);
+
+    slot->sequence.store(2ul * message + 1ul, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(reinterpret_cast<uint32_t*>(slot + 1), emigrant.data(),
+                encoding_size_ * sizeof(uint32_t));
+    slot->sequence.store(2ul * message + 2ul, std::memory_order_release);
+    head->store(++message, std::memory_order_release);
+  }
+
+  uint64_t last = GetHead(previous)->load(std::memory_order_acquire);
+
+  tail_ = std::max(tail_, last > ring_capacity_ ? last - ring_capacity_ : 0ul);
+
+  for (; tail_ < last; ++tail_) {
+    Slot* slot = GetSlot(previous, tail_ % ring_capacity_);
+    std::vector<uint32_t> immigrant(encoding_size_);
+    uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+
+    std::memcpy(immigrant.data(), reinterpret_cast<uint32_t*>(slot + 1),
+                encoding_size_ * sizeof(uint32_t));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (sequence == 2ul * tail_ + 2ul
+        && slot->sequence.load(std::memory_order_relaxed) == sequence) {
+      immigrants.push_back(std::move(immigrant));
+    }
+  }
+
+  return immigrants;
+}  // std::vector<std::vector<uint32_t>> IslandModel::Migrate(...)
+
+/**
+ * The island builds its own instance of the engine, which reads the input files again, and seeds
+ * \c rand() with its number plus one; the island zero draws as a run of the engine alone. The
+ * elite are the \c --migration_size best distinct incumbents of the runs.
+ *
+ * \param[in]   island  The number of the island
+ * \param[out]  code    The encoding of the best solution of the island
+ */
+void IslandModel::RunIsland(size_t island, std::vector<uint32_t>& code) {
+  std::shared_ptr<Algorithm> engine = ReturnAlgorithm(FLAGS_island_engine);
+  std::vector<Solution> elite;
+  std::vector<std::vector<uint32_t>> emigrants;
+  std::vector<std::vector<uint32_t>> immigrants;
+
+  srand(static_cast<unsigned int>(island + 1ul));
+  tail_ = 0ul;
+
+  engine->ReadInputFiles(FLAGS_tasks_and_files, FLAGS_cluster, FLAGS_conflict_graph);
+  engine->SetAlphas(alpha_time_, alpha_budget_, alpha_security_, alpha_restrict_candidate_list_);
+  engine->CalculateMaximumSecurityAndPrivacyExposure();
+
+  for (size_t epoch = 0ul; epoch < FLAGS_island_epochs; ++epoch) {
+    std::vector<Solution> warm_starts = elite;
+    Solution incumbent(engine.get());
+
+    for (const std::vector<uint32_t>& immigrant : immigrants) {
+      warm_starts.emplace_back(engine.get());
+      warm_starts.back().Decode(immigrant.data());
+    }
+
+    if (engine->RunSilently(warm_starts, incumbent)) {
+      bool is_new = true;
+
+      for (const Solution& solution : elite) {
+        if (engine->ComputeDistance(solution, incumbent) == 0ul) {
+          is_new = false;
+          break;
+        }
+      }
+
+      if (is_new) {
+        elite.push_back(incumbent);
+        std::sort(elite.begin(), elite.end(), [](const Solution& a, const Solution& b) {
+          return a.get_objective_value() < b.get_objective_value();
+        });
+
+        if (elite.size() > FLAGS_migration_size) {
+          elite.pop_back();
+        }
+      }
+    }
+
+    if (epoch + 1ul == FLAGS_island_epochs || AgreeToStop(IsTimeLimitReached())) {
+      break;
+    }
+
+    emigrants.assign(elite.size(), std::vector<uint32_t>(encoding_size_));
+
+    for (size_t i = 0ul; i < elite.size(); ++i) {
+      elite[i].Encode(emigrants[i].data());
+    }
+
+    immigrants = Migrate(island, emigrants);
+  }
+
+  if (elite.empty()) {
+#ifdef WF_SECURITY_MPI
+    // The other MPI islands would wait for this one at the gather forever
+    if (use_mpi_) {
+      LOG(ERROR) << "The island engine " << FLAGS_island_engine << " reported no solution";
+      MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
+#endif
+
+    LOG(FATAL) << "The island engine " << FLAGS_island_engine << " reported no solution";
+  }
+
+  code.resize(encoding_size_);
+  elite.front().Encode(code.data());
+}  // void IslandModel::RunIsland(size_t island, std::vector<uint32_t>& code)
+
+/**
+ * \param[in]  codes  The encoding of the best solution of each island
+ */
+void IslandModel::ReportResult(const std::vector<std::vector<uint32_t>>& codes) {
+  Solution best_solution(this);
+  Solution solution(this);
+  std::vector<double> objective_values;
+
+  for (const std::vector<uint32_t>& code : codes) {
+    objective_values.push_back(solution.Decode(code.data()));
+
+    if (objective_values.size() == 1ul
+        || solution.get_objective_value() < best_solution.get_objective_value()) {
+      best_solution = solution;
+    }
+  }
+
+  ReportIncumbent(best_solution);
+  ReportSolution(best_solution);
+
+  std::cout << "Islands:";
+  for (size_t i = 0ul; i < objective_values.size(); ++i) {
+    std::cout << " " << i << ":" << objective_values[i];
+  }
+  std::cout << std::endl;
+}  // void IslandModel::ReportResult(const std::vector<std::vector<uint32_t>>& codes)
+
+/**
+ * Under MPI, MPI is initialised here, if needed, and finalised at the exit; with a single MPI
+ * process the islands are forked as without MPI. The rank zero prints the result.
+ *
+ * The forked islands share an anonymous mapping, created before the forks, with one ring buffer
+ * of \c 2 * --migration_size slots per island and one result slot per island. Each island writes
+ * its best solution into its result slot and exits; this process waits for all of them, and kills
+ * the others as soon as one fails (see \c StopIslands()), as \c MPI_Abort() does under MPI.
+ */
+void IslandModel::Run() {
+  DLOG(INFO) << "Executing Island Model ...";
+
+  std::vector<std::vector<uint32_t>> codes;
+
+  if (FLAGS_island_engine == "islands") {
+    LOG(FATAL) << "The island engine cannot be the island model itself";
+  }
+
+  if (FLAGS_island_epochs == 0ul || FLAGS_migration_size == 0ul) {
+    LOG(FATAL) << "The island epochs and the migration size must be positive";
+  }
+
+  encoding_size_ = Solution::GetEncodingSize(this);
+
+#ifdef WF_SECURITY_MPI
+  int initialized = 0;
+  int rank = 0;
+  int size = 1;
+
+  MPI_Initialized(&initialized);
+
+  if (!initialized) {
+    MPI_Init(nullptr, nullptr);
+    std::atexit([] { MPI_Finalize(); });
+  }
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  if (size > 1) {
+    std::vector<uint32_t> code;
+    std::vector<uint32_t> all_codes(rank == 0 ? static_cast<size_t>(size) * encoding_size_ : 0ul);
+
+    use_mpi_ = true;
+    number_of_islands_ = static_cast<size_t>(size);
+    RunIsland(static_cast<size_t>(rank), code);
+
+    MPI_Gather(code.data(), static_cast<int>(encoding_size_), MPI_UINT32_T,
+               all_codes.data(), static_cast<int>(encoding_size_), MPI_UINT32_T,
+               0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+      for (size_t i = 0ul; i < number_of_islands_; ++i) {
+        auto begin = all_codes.begin() + static_cast<std::ptrdiff_t>(i * encoding_size_);
+
+        codes.emplace_back(begin, begin + static_cast<std::ptrdiff_t>(encoding_size_));
+      }
+
+      ReportResult(codes);
+    }
+
+    DLOG(INFO) << "... ending Island Model";
+    return;
+  }
+#endif
+
+  number_of_islands_ = FLAGS_number_of_islands;
+
+  if (number_of_islands_ == 0ul) {
+    LOG(FATAL) << "The number of islands must be positive";
+  }
+
+  ring_capacity_ = 2ul * FLAGS_migration_size;
+  slot_size_ = (sizeof(Slot) + encoding_size_ * sizeof(uint32_t) + 63ul) / 64ul * 64ul;
+  shared_memory_size_ = (number_of_islands_ + 1ul) * 64ul
+                      + number_of_islands_ * (ring_capacity_ + 1ul) * slot_size_;
+
+  void* memory = mmap(nullptr, shared_memory_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+  if (memory == MAP_FAILED) {
+    LOG(FATAL) << "Could not map " << shared_memory_size_ << " bytes for the islands";
+  }
+
+  shared_memory_ = static_cast<char*>(memory);
+
+  for (size_t island = 0ul; island <= number_of_islands_; ++island) {
+    new (GetHead(island)) std::atomic<uint64_t>(0ul);
+
+    size_t slots = island < number_of_islands_ ? ring_capacity_ : number_of_islands_;
+
+    for (size_t i = 0ul; i < slots; ++i) {
+      new (&GetSlot(island, i)->sequence) std::atomic<uint64_t>(0ul);
+    }
+  }
+
+  // The children would print again what is left in the buffers
+  std::cout.flush();
+  std::cerr.flush();
+  google::FlushLogFiles(google::INFO);
+
+  std::vector<pid_t> children;
+
+  for (size_t island = 0ul; island < number_of_islands_; ++island) {
+    pid_t pid = fork();
+
+    if (pid < 0) {
+      StopIslands(children, 0ul);
+      LOG(FATAL) << "Could not fork the island " << island;
+    }
+
+    if (pid == 0) {
+      std::vector<uint32_t> code;
+      Slot* result = GetSlot(number_of_islands_, island);
+
+      RunIsland(island, code);
+      std::memcpy(reinterpret_cast<uint32_t*>(result + 1), code.data(),
+                  encoding_size_ * sizeof(uint32_t));
+      result->sequence.store(2ul, std::memory_order_release);
+      _exit(0);
+    }
+
+    children.push_back(pid);
+  }
+
+  for (size_t island = 0ul; island < children.size(); ++island) {
+    int status = 0;
+
+    if (waitpid(children[island], &status, 0) < 0 || !WIFEXITED(status)
+        || WEXITSTATUS(status) != 0) {
+      StopIslands(children, island + 1ul);
+      LOG(FATAL) << "The island " << island << " failed";
+    }
+
+    Slot* result = GetSlot(number_of_islands_, island);
+    const uint32_t* code = reinterpret_cast<const uint32_t*>(result + 1);
+
+    if (result->sequence.load(std::memory_order_acquire) != 2ul) {
+      StopIslands(children, island + 1ul);
+      LOG(FATAL) << "The island " << island << " wrote no result";
+    }
+
+    codes.emplace_back(code, code + encoding_size_);
+  }
+
+  munmap(shared_memory_, shared_memory_size_);
+  shared_memory_ = nullptr;
+
+  ReportResult(codes);
+
+  DLOG(INFO) << "... ending Island Model";
+}  // void IslandModel::Run()
@@ -0,0 +1,101 @@
+/**
+ * \file src/solution/island_model.h
+ * \brief Contains the \c IslandModel class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This header file contains the \c IslandModel class that runs one algorithm per process and
+ * migrates the best solutions between them.
+ */
+
+#ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_ISLAND_MODEL_H_
+#define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_ISLAND_MODEL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "src/solution/algorithm.h"
+
+/**
+ * \class IslandModel island_model.h "src/solution/island_model.h"
+ * \brief Island model over processes, with a ring migration of the elite solutions
+ *
+ * Each island is a process that runs the \c --island_engine algorithm, as the GRASP or the ILS,
+ * with its own seed, for \c --island_epochs silent runs (see \c Algorithm::RunSilently()). After
+ * each run but the last, the island sends its \c --migration_size best distinct solutions to the
+ * next island of the ring and receives those of the previous one; the next run starts from its
+ * elite and the immigrants.
+ *
+ * The islands are \c --number_of_islands processes forked from this one, which share a ring
+ * buffer of encoded solutions per island (see \c Solution::Encode()); a slow island reads the
+ * latest migrants and never blocks the others. Built with \c WF_SECURITY_MPI and launched by
+ * \c mpirun with more than one process, each MPI process is an island instead and the migrants
+ * are exchanged by messages; the islands then migrate in lockstep.
+ */
+class IslandModel : public Algorithm {
+ public:
+  /// Default constructor
+  IslandModel() = default;
+
+  /// Default destructor
+  ~IslandModel() = default;
+
+  /// Run the islands; print the best solution found by them
+  void Run(void);
+
+ private:
+  /// A slot of a ring buffer; the encoding of the solution follows it in the shared memory
+  struct Slot {
+    /// Odd while the slot is written; twice the number of the message plus two once written
+    std::atomic<uint64_t> sequence;
+  };
+
+  /// Run the island \c island; write the encoding of its best solution into \c code
+  void RunIsland(size_t island, std::vector<uint32_t>& code);
+
+  /// Send the \c emigrants to the next island; return the immigrants from the previous one
+  std::vector<std::vector<uint32_t>> Migrate(size_t island,
+                                             const std::vector<std::vector<uint32_t>>& emigrants);
+
+  /// Return true if any island must stop; every island must call it at each epoch under MPI
+  bool AgreeToStop(bool stop);
+
+  /// Return the slot \c index of the ring of \c island; the ring after the last holds the results
+  Slot* GetSlot(size_t island, size_t index);
+
+  /// Return the message counter of the ring buffer of the island \c island
+  std::atomic<uint64_t>* GetHead(size_t island);
+
+  /// Print the value of each island and the best solution of the \c codes
+  void ReportResult(const std::vector<std::vector<uint32_t>>& codes);
+
+  /// Number of islands
+  size_t number_of_islands_ = 0ul;
+
+  /// Whether the islands are MPI processes
+  bool use_mpi_ = false;
+
+  /// Number of integers of the encoding of a solution
+  size_t encoding_size_ = 0ul;
+
+  /// Size in bytes of a slot and its encoding, rounded up to keep the slots aligned
+  size_t slot_size_ = 0ul;
+
+  /// Number of slots of each ring buffer
+  size_t ring_capacity_ = 0ul;
+
+  /// The ring buffers, then one result slot per island, shared by the forked islands
+  char* shared_memory_ = nullptr;
+
+  /// Size in bytes of \c shared_memory_
+  size_t shared_memory_size_ = 0ul;
+
+  /// Number of messages already read from the ring buffer of the previous island
+  uint64_t tail_ = 0ul;
+};  // end of class IslandModel
+
+#endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_ISLAND_MODEL_H_
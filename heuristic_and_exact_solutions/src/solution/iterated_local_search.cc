@@ -0,0 +1,150 @@
+/**
+ * \file src/solution/iterated_local_search.cc
+ * \brief Contains the \c IteratedLocalSearch class methods.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This source file contains the methods from the \c IteratedLocalSearch class that run the
+ * Iterated Local Search.
+ */
+
+#include "src/solution/iterated_local_search.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "src/model/dynamic_file.h"
+
+DECLARE_uint64(number_of_iteration);
+DECLARE_uint64(ils_perturbation_strength);
+DECLARE_uint64(ils_max_perturbation_strength);
+DECLARE_double(ils_acceptance_threshold);
+
+/**
+ * Each of the \c strength changes picks, with the same probability, a random task moved to a
+ * random other VM, or a random dynamic file moved to a random storage that keeps the solution
+ * feasible; a file with no such storage, or never stored, is left in place. The perturbed solution
+ * is evaluated once, at the end.
+ *
+ * \param[in]   solution  The solution to be perturbed
+ * \param[in]   strength  The number of reassigned tasks and files
+ * \param[out]  tasks     The reassigned tasks
+ * \param[out]  files     The reassigned files
+ */
+void IteratedLocalSearch::Perturb(Solution& solution,
+                                  size_t strength,
+                                  std::vector<size_t>& tasks,
+                                  std::vector<size_t>& files) {
+  std::vector<size_t> storages;
+
+  tasks.clear();
+  files.clear();
+
+  for (size_t i = 0ul; i < strength; ++i) {
+    if (rand() % 2 == 0 && GetVirtualMachineSize() > 1ul) {
+      // Any task but the source and the target ones
+      size_t task_id = 1ul + static_cast<size_t>(rand()) % (GetTaskSize() - 2ul);
+      size_t vm_id = static_cast<size_t>(rand()) % (GetVirtualMachineSize() - 1ul);
+
+      if (vm_id >= solution.GetTaskAllocation(task_id)) {
+        ++vm_id;  // Skip the current VM
+      }
+
+      solution.MoveTask(task_id, vm_id, false);
+      tasks.push_back(task_id);
+    } else if (dynamic_file_size_ > 0ul) {
+      size_t file_id = static_file_size_ + static_cast<size_t>(rand()) % dynamic_file_size_;
+
+      if (solution.GetFileAllocation(file_id) == std::numeric_limits<size_t>::max()) {
+        continue;  // A dynamic file without a producer is never stored
+      }
+
+      storages.clear();
+      for (size_t storage_id = 0ul; storage_id < GetStorageSize(); ++storage_id) {
+        if (storage_id != solution.GetFileAllocation(file_id)
+            && solution.CanMoveFile(file_id, storage_id)) {
+          storages.push_back(storage_id);
+        }
+      }
+
+      if (!storages.empty()) {
+        solution.MoveFile(file_id, storages[static_cast<size_t>(rand()) % storages.size()], false);
+        files.push_back(file_id);
+      }
+    }
+  }
+
+  solution.Evaluate();
+}  // void IteratedLocalSearch::Perturb(...)
+
+/**
+ * The local search is a descent over the task and the file moves, focused on the perturbed tasks
+ * and files and their neighbours (see \c LocalSearch::Focus()), so an iteration evaluates a few
+ * moves instead of the whole neighbourhoods. The new local optimum becomes the current solution
+ * when it is within \c --ils_acceptance_threshold, relative, of the best solution; otherwise the
+ * search goes on from the best one.
+ */
+void IteratedLocalSearch::Run() {
+  DLOG(INFO) << "Executing Iterated Local Search...";
+
+  const std::vector<LocalSearch::Neighbourhood> neighbourhoods = {LocalSearch::kMoveTask,
+                                                                  LocalSearch::kMoveFile};
+  LocalSearch local_search(this);
+  std::vector<size_t> tasks;
+  std::vector<size_t> files;
+  size_t strength = FLAGS_ils_perturbation_strength;
+
+  if (strength == 0ul || FLAGS_ils_max_perturbation_strength < strength) {
+    LOG(FATAL) << "Invalid ILS perturbation strengths: " << FLAGS_ils_perturbation_strength
+        << " to " << FLAGS_ils_max_perturbation_strength;
+  }
+
+  Solution current_solution(this);
+
+  ConstructInitialSolution(current_solution);
+  local_search.Descent(current_solution, neighbourhoods);
+
+  Solution best_solution = current_solution;
+
+  ReportIncumbent(best_solution);
+
+  for (size_t i = 0ul; i < FLAGS_number_of_iteration && !IsTimeLimitReached(); ++i) {
+    Solution solution = current_solution;
+
+    Perturb(solution, strength, tasks, files);
+
+    local_search.Focus(tasks, files);
+    local_search.Descent(solution, neighbourhoods);
+
+    if (solution.get_objective_value() < best_solution.get_objective_value()) {
+      best_solution = solution;
+      strength = FLAGS_ils_perturbation_strength;
+      ReportIncumbent(best_solution);
+    } else {
+      strength = std::min(strength + 1ul, FLAGS_ils_max_perturbation_strength);
+    }
+
+    if (solution.get_objective_value()
+        <= best_solution.get_objective_value() * (1.0 + FLAGS_ils_acceptance_threshold)) {
+      current_solution = solution;
+    } else {
+      current_solution = best_solution;
+    }
+  }
+
+  // Recompute the values from scratch, no incremental drift
+  best_solution.ObjectiveFunction(false, false);
+
+  ReportSolution(best_solution);
+  local_search.ReportStatistics();
+
+  DLOG(INFO) << "... ending Iterated Local Search";
+}  // end of IteratedLocalSearch::Run() method
@@ -0,0 +1,52 @@
+/**
+ * \file src/solution/iterated_local_search.h
+ * \brief Contains the \c IteratedLocalSearch class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This header file contains the \c IteratedLocalSearch class that improves a constructed solution
+ * alternating perturbations and local searches.
+ */
+
+#ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_ITERATED_LOCAL_SEARCH_H_
+#define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_ITERATED_LOCAL_SEARCH_H_
+
+#include <vector>
+
+#include "src/solution/algorithm.h"
+#include "src/solution/local_search.h"
+
+/**
+ * \class IteratedLocalSearch iterated_local_search.h "src/solution/iterated_local_search.h"
+ * \brief Iterated Local Search over the task and file allocations
+ *
+ * Starts from the HEFT solution (see \c Algorithm::ConstructInitialSolution()). Each iteration
+ * reassigns k random tasks or dynamic files of the current solution and descends over the task and
+ * file moves around them. The strength k starts at \c --ils_perturbation_strength, grows by one at
+ * each iteration without a new best solution, up to \c --ils_max_perturbation_strength, and is
+ * reset by a new best. The search stops after \c --number_of_iteration iterations or at the time
+ * limit.
+ */
+class IteratedLocalSearch : public Algorithm {
+ public:
+  /// Default constructor
+  IteratedLocalSearch() = default;
+
+  /// Default destructor
+  ~IteratedLocalSearch() = default;
+
+  /// Construct the initial solution; iterate perturbations and local searches; print the best
+  void Run(void);
+
+ private:
+  /// Reassign \c strength random tasks or files of \c solution; record them in \c tasks, \c files
+  void Perturb(Solution& solution,
+               size_t strength,
+               std::vector<size_t>& tasks,
+               std::vector<size_t>& files);
+};  // end of class IteratedLocalSearch
+
+#endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_ITERATED_LOCAL_SEARCH_H_
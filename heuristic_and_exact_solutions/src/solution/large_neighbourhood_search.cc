@@ -0,0 +1,337 @@
+/**
+ * \file src/solution/large_neighbourhood_search.cc
+ * \brief Contains the \c LargeNeighbourhoodSearch class methods.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This source file contains the methods from the \c LargeNeighbourhoodSearch class that run the
+ * Adaptive Large Neighbourhood Search.
+ */
+
+#include "src/solution/large_neighbourhood_search.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <queue>
+#include <vector>
+
+#include "src/model/dynamic_file.h"
+
+DECLARE_uint64(number_of_iteration);
+DECLARE_uint64(lns_min_destroy_size);
+DECLARE_uint64(lns_max_destroy_size);
+DECLARE_uint64(lns_update_period);
+DECLARE_double(lns_reaction_factor);
+
+/// Names of the destroy operators, in the order of \c LargeNeighbourhoodSearch::DestroyOperator
+static const char* kDestroyOperatorNames[] = {"level", "virtual_machine", "conflict_component",
+                                              "critical_path_segment"};
+
+/// Minimal weight of a destroy operator relative to the largest one, so that none is abandoned
+static const double kMinimalWeight = 0.05;
+
+/**
+ * \retval  destroy_operator  The drawn operator
+ */
+LargeNeighbourhoodSearch::DestroyOperator LargeNeighbourhoodSearch::SelectOperator() const {
+  double total = 0.0;
+
+  for (double weight : weights_) {
+    total += weight;
+  }
+
+  double draw = total * static_cast<double>(rand()) / (static_cast<double>(RAND_MAX) + 1.0);
+
+  for (size_t k = 0ul; k + 1ul < kNumberOfDestroyOperators; ++k) {
+    if (draw < weights_[k]) {
+      return static_cast<DestroyOperator>(k);
+    }
+    draw -= weights_[k];
+  }
+
+  return static_cast<DestroyOperator>(kNumberOfDestroyOperators - 1ul);
+}  // LargeNeighbourhoodSearch::DestroyOperator LargeNeighbourhoodSearch::SelectOperator() const
+
+/**
+ * The operators mark, in \c destroyed_tasks_ and \c destroyed_files_:
+ *
+ * 1. \c kLevel: the tasks of a random height, in random order, then those of the next heights;
+ * 2. \c kVirtualMachine: the tasks of the VM of a random task, in random order;
+ * 3. \c kConflictComponent: the stored dynamic files reached by a breadth-first search over the
+ *    conflicts from a random one, and their producers;
+ * 4. \c kCriticalPathSegment: the consecutive tasks of the critical path of the \c solution from a
+ *    random one (see \c Solution::GetCriticalPath()); the solutions are always evaluated here.
+ *
+ * The output files of the destroyed tasks are also destroyed, since the insertion places them
+ * again; the files are counted only by \c kConflictComponent.
+ *
+ * \param[in]  solution          The current solution
+ * \param[in]  destroy_operator  The operator
+ * \param[in]  size              The maximum number of destroyed tasks, or files
+ * \retval     destroyed         The number of destroyed tasks, or files
+ */
+size_t LargeNeighbourhoodSearch::Destroy(const Solution& solution,
+                                         DestroyOperator destroy_operator,
+                                         size_t size) {
+  std::vector<size_t> tasks;
+  size_t destroyed = 0ul;
+
+  destroyed_tasks_.assign(GetTaskSize(), false);
+  destroyed_files_.assign(GetFileSize(), false);
+
+  // Any task but the source and the target ones
+  size_t task_id = 1ul + static_cast<size_t>(rand()) % (GetTaskSize() - 2ul);
+
+  if (destroy_operator == kLevel) {
+    for (size_t level = static_cast<size_t>(height_[task_id]);
+         level < levels_.size() && tasks.size() < size; ++level) {
+      std::vector<size_t> level_tasks(levels_[level]);
+
+      std::shuffle(level_tasks.begin(), level_tasks.end(), generator_);
+      level_tasks.resize(std::min(level_tasks.size(), size - tasks.size()));
+      tasks.insert(tasks.end(), level_tasks.begin(), level_tasks.end());
+    }
+  } else if (destroy_operator == kVirtualMachine) {
+    for (size_t id = 1ul; id + 1ul < GetTaskSize(); ++id) {
+      if (solution.GetTaskAllocation(id) == solution.GetTaskAllocation(task_id)) {
+        tasks.push_back(id);
+      }
+    }
+
+    std::shuffle(tasks.begin(), tasks.end(), generator_);
+    tasks.resize(std::min(tasks.size(), size));
+  } else if (destroy_operator == kConflictComponent) {
+    if (dynamic_file_size_ == 0ul) {
+      return 0ul;
+    }
+
+    size_t file_id = static_file_size_ + static_cast<size_t>(rand()) % dynamic_file_size_;
+    std::queue<size_t> queue;
+
+    if (solution.GetFileAllocation(file_id) == std::numeric_limits<size_t>::max()) {
+      return 0ul;  // A dynamic file without a producer is never stored
+    }
+
+    destroyed_files_[file_id] = true;
+    queue.push(file_id);
+
+    while (!queue.empty() && destroyed < size) {
+      file_id = queue.front();
+      queue.pop();
+      ++destroyed;
+
+      Task* producer = dynamic_cast<DynamicFile*>(files_[file_id])->get_parent_task();
+
+      if (producer != nullptr) {
+        tasks.push_back(producer->get_id());
+      }
+
+      for (const auto& conflict : conflict_graph_.GetConflicts(file_id)) {
+        if (conflict.first >= static_file_size_ && !destroyed_files_[conflict.first]
+            && solution.GetFileAllocation(conflict.first) != std::numeric_limits<size_t>::max()) {
+          destroyed_files_[conflict.first] = true;
+          queue.push(conflict.first);
+        }
+      }
+    }
+
+    // The files left in the queue were never destroyed
+    for (; !queue.empty(); queue.pop()) {
+      destroyed_files_[queue.front()] = false;
+    }
+  } else {
+    std::vector<size_t> critical_tasks = solution.GetCriticalPath();
+
+    if (!critical_tasks.empty()) {
+      size_t first = static_cast<size_t>(rand()) % critical_tasks.size();
+      size_t last = std::min(critical_tasks.size(), first + size);
+
+      tasks.assign(critical_tasks.begin() + static_cast<std::ptrdiff_t>(first),
+                   critical_tasks.begin() + static_cast<std::ptrdiff_t>(last));
+    }
+  }
+
+  for (size_t id : tasks) {
+    destroyed_tasks_[id] = true;
+
+    for (File* file : tasks_[id]->get_output_files()) {
+      destroyed_files_[file->get_id()] = true;
+    }
+  }
+
+  return destroy_operator == kConflictComponent ? destroyed : tasks.size();
+}  // size_t LargeNeighbourhoodSearch::Destroy(...)
+
+/**
+ * The tasks are scheduled again in the order of \c solution, which is topological: the kept tasks
+ * at their VMs and the destroyed ones at the VM that minimises the objective value of the partial
+ * solution (see \c Algorithm::ScheduleTaskAtBestVirtualMachine()), as the constructive heuristics
+ * do. The scheduling places the output files at their best storages; the kept files are then
+ * moved back to their storages in \c solution, when it stays feasible. The \c repaired solution
+ * starts as a copy of \c empty_solution, which reuses its buffers instead of allocating them.
+ *
+ * \param[in]   solution        The destroyed solution
+ * \param[in]   empty_solution  A solution with only the static files allocated
+ * \param[out]  repaired        The repaired solution, evaluated
+ */
+void LargeNeighbourhoodSearch::Repair(const Solution& solution,
+                                      const Solution& empty_solution,
+                                      Solution& repaired) {
+  repaired = empty_solution;
+
+  for (size_t task_id : solution.get_ordering()) {
+    if (destroyed_tasks_[task_id]) {
+      ScheduleTaskAtBestVirtualMachine(tasks_[task_id], repaired);
+    } else {
+      repaired.ScheduleTask(tasks_[task_id],
+                            virtual_machines_[solution.GetTaskAllocation(task_id)]);
+    }
+  }
+
+  for (size_t file_id = static_file_size_; file_id < GetFileSize(); ++file_id) {
+    size_t storage_id = solution.GetFileAllocation(file_id);
+
+    if (!destroyed_files_[file_id] && storage_id != std::numeric_limits<size_t>::max()
+        && repaired.GetFileAllocation(file_id) != storage_id
+        && repaired.CanMoveFile(file_id, storage_id)) {
+      repaired.MoveFile(file_id, storage_id, false);
+    }
+  }
+
+  repaired.ObjectiveFunction(false, false);
+}  // void LargeNeighbourhoodSearch::Repair(...)
+
+/**
+ * The weight of an operator used in the period moves toward its rate of improvement, improvements
+ * over destroys: \f$w \leftarrow (1 - r) w + r \cdot rate\f$, with \f$r\f$ the
+ * \c --lns_reaction_factor. A period without any improvement keeps the weights, so they do not
+ * all vanish at a local optimum. No weight goes under \c kMinimalWeight times the largest one.
+ */
+void LargeNeighbourhoodSearch::UpdateWeights() {
+  size_t improvements = 0ul;
+  double largest = 0.0;
+
+  for (size_t improvement : period_improvements_) {
+    improvements += improvement;
+  }
+
+  for (size_t k = 0ul; k < kNumberOfDestroyOperators && improvements > 0ul; ++k) {
+    if (period_destroys_[k] > 0ul) {
+      double rate = static_cast<double>(period_improvements_[k])
+          / static_cast<double>(period_destroys_[k]);
+
+      weights_[k] = (1.0 - FLAGS_lns_reaction_factor) * weights_[k]
+                  + FLAGS_lns_reaction_factor * rate;
+    }
+  }
+
+  for (double weight : weights_) {
+    largest = std::max(largest, weight);
+  }
+
+  for (double& weight : weights_) {
+    weight = std::max(weight, kMinimalWeight * largest);
+  }
+
+  period_destroys_.fill(0ul);
+  period_improvements_.fill(0ul);
+}  // void LargeNeighbourhoodSearch::UpdateWeights()
+
+/**
+ * Print to the standard output the number of destroys, of improvements and the final weight of
+ * each destroy operator.
+ */
+void LargeNeighbourhoodSearch::ReportStatistics() const {
+  for (size_t k = 0ul; k < kNumberOfDestroyOperators; ++k) {
+    std::cout << "LNS " << kDestroyOperatorNames[k] << ": " << improvements_[k]
+        << " improvements, " << destroys_[k] << " destroys, weight " << weights_[k] << std::endl;
+  }
+}  // void LargeNeighbourhoodSearch::ReportStatistics() const
+
+/**
+ * Only the improving repairs are accepted, so the current solution is always the best one. An
+ * empty destroy, as a conflict component of an unstored file, counts as a failed one.
+ */
+void LargeNeighbourhoodSearch::Run() {
+  DLOG(INFO) << "Executing Large Neighbourhood Search...";
+
+  size_t size = FLAGS_lns_min_destroy_size;
+
+  if (size == 0ul || FLAGS_lns_max_destroy_size < size) {
+    LOG(FATAL) << "Invalid LNS destroy sizes: " << FLAGS_lns_min_destroy_size
+        << " to " << FLAGS_lns_max_destroy_size;
+  }
+
+  if (FLAGS_lns_update_period == 0ul || FLAGS_lns_reaction_factor < 0.0
+      || FLAGS_lns_reaction_factor > 1.0) {
+    LOG(FATAL) << "Invalid LNS weight update: period " << FLAGS_lns_update_period
+        << ", reaction factor " << FLAGS_lns_reaction_factor;
+  }
+
+  levels_.clear();
+
+  for (size_t task_id = 1ul; task_id + 1ul < GetTaskSize(); ++task_id) {
+    size_t level = static_cast<size_t>(height_[task_id]);
+
+    if (levels_.size() <= level) {
+      levels_.resize(level + 1ul);
+    }
+
+    levels_[level].push_back(task_id);
+  }
+
+  generator_.seed(static_cast<std::mt19937::result_type>(rand()));
+  weights_.fill(1.0);
+  period_destroys_.fill(0ul);
+  period_improvements_.fill(0ul);
+  destroys_.fill(0ul);
+  improvements_.fill(0ul);
+
+  Solution best_solution(this);
+  Solution empty_solution(this);
+
+  AllocateStaticFiles(empty_solution);
+
+  Solution solution = empty_solution;
+
+  ConstructInitialSolution(best_solution);
+  ReportIncumbent(best_solution);
+
+  for (size_t i = 0ul; i < FLAGS_number_of_iteration && !IsTimeLimitReached(); ++i) {
+    DestroyOperator destroy_operator = SelectOperator();
+
+    ++destroys_[destroy_operator];
+    ++period_destroys_[destroy_operator];
+
+    if (Destroy(best_solution, destroy_operator, size) > 0ul) {
+      Repair(best_solution, empty_solution, solution);
+    }
+
+    if (solution.get_objective_value() < best_solution.get_objective_value()) {
+      best_solution = solution;
+      size = FLAGS_lns_min_destroy_size;
+      ++improvements_[destroy_operator];
+      ++period_improvements_[destroy_operator];
+      ReportIncumbent(best_solution);
+    } else {
+      size = std::min(size + 1ul, FLAGS_lns_max_destroy_size);
+    }
+
+    if ((i + 1ul) % FLAGS_lns_update_period == 0ul) {
+      UpdateWeights();
+    }
+  }
+
+  ReportSolution(best_solution);
+  ReportStatistics();
+
+  DLOG(INFO) << "... ending Large Neighbourhood Search";
+}  // end of LargeNeighbourhoodSearch::Run() method
@@ -0,0 +1,102 @@
+/**
+ * \file src/solution/large_neighbourhood_search.h
+ * \brief Contains the \c LargeNeighbourhoodSearch class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This header file contains the \c LargeNeighbourhoodSearch class that improves a solution by
+ * destroying and repairing parts of it.
+ */
+
+#ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_LARGE_NEIGHBOURHOOD_SEARCH_H_
+#define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_LARGE_NEIGHBOURHOOD_SEARCH_H_
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include "src/solution/algorithm.h"
+
+/**
+ * \class LargeNeighbourhoodSearch large_neighbourhood_search.h
+ *        "src/solution/large_neighbourhood_search.h"
+ * \brief Adaptive Large Neighbourhood Search over the task and file allocations
+ *
+ * Starts from the HEFT solution (see \c Algorithm::ConstructInitialSolution()). Each iteration
+ * destroys a structured part of the current solution, chosen by an operator drawn by roulette,
+ * and repairs it with the constructive insertion (see \c Repair()); the repaired solution
+ * replaces the current one if it is better. The destroy size starts at
+ * \c --lns_min_destroy_size, grows by one at each iteration without improvement, up to
+ * \c --lns_max_destroy_size, and is reset by an improvement. Every \c --lns_update_period
+ * iterations, the weight of each operator moves toward its rate of improvements by the
+ * \c --lns_reaction_factor. The search stops after \c --number_of_iteration iterations or at the
+ * time limit.
+ */
+class LargeNeighbourhoodSearch : public Algorithm {
+ public:
+  /// The destroy operators
+  enum DestroyOperator {
+    kLevel = 0,             ///< Tasks of the same height, from a random one on
+    kVirtualMachine,        ///< Tasks of a random Virtual Machine
+    kConflictComponent,     ///< Dynamic files of a component of the conflict graph, and producers
+    kCriticalPathSegment,   ///< Consecutive tasks of the critical path of the solution
+    kNumberOfDestroyOperators
+  };
+
+  /// Default constructor
+  LargeNeighbourhoodSearch() = default;
+
+  /// Default destructor
+  ~LargeNeighbourhoodSearch() = default;
+
+  /// Construct the initial solution; iterate the destroys and repairs; print the best solution
+  void Run(void);
+
+ private:
+  /// Draw a destroy operator with a probability proportional to its weight
+  DestroyOperator SelectOperator() const;
+
+  /// Mark up to \c size tasks or files of \c solution by the \c destroy_operator; return the number
+  size_t Destroy(const Solution& solution, DestroyOperator destroy_operator, size_t size);
+
+  /// Rebuild \c solution into \c repaired, inserting the destroyed tasks at their best VMs
+  void Repair(const Solution& solution, const Solution& empty_solution, Solution& repaired);
+
+  /// Move the weights toward the rates of improvement of the last period; reset the counters
+  void UpdateWeights();
+
+  /// Print the destroys, improvements and weight of each operator
+  void ReportStatistics() const;
+
+  /// Generator of the shuffles of the destroyed tasks; seeded by \c rand()
+  std::mt19937 generator_;
+
+  /// Tasks of each height, except the source and the target
+  std::vector<std::vector<size_t>> levels_;
+
+  /// Whether each task is destroyed
+  std::vector<bool> destroyed_tasks_;
+
+  /// Whether each file is destroyed; the output files of the destroyed tasks are
+  std::vector<bool> destroyed_files_;
+
+  /// Weight of each destroy operator
+  std::array<double, kNumberOfDestroyOperators> weights_{};
+
+  /// Number of destroys per operator in the current period
+  std::array<size_t, kNumberOfDestroyOperators> period_destroys_{};
+
+  /// Number of improvements per operator in the current period
+  std::array<size_t, kNumberOfDestroyOperators> period_improvements_{};
+
+  /// Number of destroys per operator
+  std::array<size_t, kNumberOfDestroyOperators> destroys_{};
+
+  /// Number of improvements per operator
+  std::array<size_t, kNumberOfDestroyOperators> improvements_{};
+};  // end of class LargeNeighbourhoodSearch
+
+#endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_LARGE_NEIGHBOURHOOD_SEARCH_H_
@@ -0,0 +1,551 @@
+/**
+ * \file src/solution/local_search.cc
+ * \brief Contains the \c LocalSearch class methods.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This source file contains the methods from the \c LocalSearch class that run the Variable
+ * Neighbourhood Descent.
+ */
+
+#include "src/solution/local_search.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "src/model/dynamic_file.h"
+
+DECLARE_string(local_search);
+DECLARE_bool(critical_path_moves);
+
+/// Names of the neighbourhoods, in the order of \c LocalSearch::Neighbourhood
+static const char* kNeighbourhoodNames[] = {"move_task", "swap_tasks", "move_file", "swap_files"};
+
+/// Minimal decrease of the objective value accepted as an improvement
+static const double kImprovementThreshold = 1e-9;
+
+/**
+ * \param[in]  algorithm  The algorithm that holds the instance
+ */
+LocalSearch::LocalSearch(Algorithm* algorithm)
+    : algorithm_(algorithm),
+      critical_path_moves_(FLAGS_critical_path_moves) {
+  if (FLAGS_local_search == "first") {
+    enabled_ = true;
+  } else if (FLAGS_local_search == "best") {
+    enabled_ = true;
+    best_improvement_ = true;
+  } else if (FLAGS_local_search != "none") {
+    LOG(FATAL) << "Invalid local search: " << FLAGS_local_search;
+  }
+}  // LocalSearch::LocalSearch(Algorithm* algorithm)
+
+/**
+ * The complete \c solution is evaluated first with \c Solution::ObjectiveFunction(), so the
+ * constructive values are replaced by the ones of the simulation. Each move is then evaluated
+ * incrementally (see \c Descent()).
+ *
+ * \param[in]  solution         The complete solution to be improved
+ * \retval     objective_value  The objective value of the local optimum
+ */
+double LocalSearch::VariableNeighbourhoodDescent(Solution& solution) {
+  solution.ObjectiveFunction(false, false);
+
+  return Descent(solution, {kMoveTask, kSwapTasks, kMoveFile, kSwapFiles});
+}  // double LocalSearch::VariableNeighbourhoodDescent(Solution& solution)
+
+/**
+ * The \c neighbourhoods are explored in the given order; after an improvement the descent restarts
+ * from the first one. The descent stops at the time limit. The \c solution is first indexed for
+ * the incremental moves, with one replay (see \c Solution::PrepareIncrementalEvaluation()).
+ *
+ * \param[in]  solution         The evaluated solution to be improved
+ * \param[in]  neighbourhoods   The neighbourhoods of the descent
+ * \retval     objective_value  The objective value of the local optimum
+ */
+double LocalSearch::Descent(Solution& solution, const std::vector<Neighbourhood>& neighbourhoods) {
+  size_t k = 0ul;
+
+  solution.PrepareIncrementalEvaluation();
+
+  while (k < neighbourhoods.size() && !algorithm_->IsTimeLimitReached()) {
+    Neighbourhood neighbourhood = neighbourhoods[k];
+    auto start = std::chrono::steady_clock::now();
+
+    bool improved = Explore(solution, neighbourhood);
+
+    time_[neighbourhood] += std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                                          - start).count();
+
+    if (improved) {
+      ++improvements_[neighbourhood];
+      k = 0ul;
+    } else {
+      ++k;
+    }
+  }
+
+  return solution.get_objective_value();
+}  // double LocalSearch::Descent(...)
+
+/**
+ * Besides the given ones, the predecessors and the successors of the \c tasks become active, as
+ * well as the dynamic files read or written by the active tasks: their best places are the ones
+ * that change with the given tasks and files.
+ *
+ * \param[in]  tasks  The tasks that changed
+ * \param[in]  files  The files that changed
+ */
+void LocalSearch::Focus(const std::vector<size_t>& tasks, const std::vector<size_t>& files) {
+  focused_ = true;
+  active_tasks_.assign(algorithm_->GetTaskSize(), false);
+  active_files_.assign(algorithm_->GetFileSize(), false);
+
+  for (size_t task_id : tasks) {
+    active_tasks_[task_id] = true;
+
+    for (size_t predecessor_id : algorithm_->GetPredecessors(task_id)) {
+      active_tasks_[predecessor_id] = true;
+    }
+
+    for (size_t successor_id : algorithm_->GetSuccessors(task_id)) {
+      active_tasks_[successor_id] = true;
+    }
+  }
+
+  for (size_t task_id = 0ul; task_id < algorithm_->GetTaskSize(); ++task_id) {
+    if (active_tasks_[task_id]) {
+      Task* task = algorithm_->GetTaskPerId(task_id);
+
+      for (File* file : task->get_input_files()) {
+        active_files_[file->get_id()] = true;
+      }
+
+      for (File* file : task->get_output_files()) {
+        active_files_[file->get_id()] = true;
+      }
+    }
+  }
+
+  for (size_t file_id : files) {
+    active_files_[file_id] = true;
+  }
+}  // void LocalSearch::Focus(...)
+
+/**
+ * Every move is applied and evaluated incrementally, then undone by the reverse move; the previous
+ * makespan and cost are restored afterwards, so the deltas of the two moves do not drift. The
+ * \c solution must be indexed by \c Solution::PrepareIncrementalEvaluation(), as \c Descent()
+ * does. With the first improvement strategy, the first improving move is kept; with the
+ * best improvement one, the best move is applied again at the end. The incremental moves keep the
+ * critical path up to date, so \c GetMoves() needs no replay.
+ *
+ * \param[in]  solution       The solution to be improved
+ * \param[in]  neighbourhood  The neighbourhood to be explored
+ * \retval     improved       True if an improving move was applied
+ */
+bool LocalSearch::Explore(Solution& solution, Neighbourhood neighbourhood) {
+  const double makespan = solution.get_makespan();
+  const double cost = solution.get_cost();
+  const double objective_value = solution.get_objective_value();
+  double best_objective_value = objective_value - kImprovementThreshold;
+  std::pair<size_t, size_t> best_move(std::numeric_limits<size_t>::max(),
+                                      std::numeric_limits<size_t>::max());
+
+  for (const auto& move : GetMoves(solution, neighbourhood)) {
+    if (algorithm_->IsTimeLimitReached()) {
+      break;
+    }
+
+    // The reverse of a swap is the swap itself; the reverse of a move is the old place
+    size_t reverse = move.second;
+
+    if (neighbourhood == kMoveTask) {
+      reverse = solution.GetTaskAllocation(move.first);
+    } else if (neighbourhood == kMoveFile) {
+      reverse = solution.GetFileAllocation(move.first);
+    }
+
+    double new_objective_value = ApplyMove(solution, neighbourhood, move.first, move.second);
+
+    ++evaluations_[neighbourhood];
+
+    if (new_objective_value < best_objective_value) {
+      if (!best_improvement_) {
+        return true;
+      }
+
+      best_objective_value = new_objective_value;
+      best_move = move;
+    }
+
+    ApplyMove(solution, neighbourhood, move.first, reverse);
+    solution.RestoreEvaluation(makespan, cost);
+  }
+
+  if (best_move.first == std::numeric_limits<size_t>::max()) {
+    return false;
+  }
+
+  ApplyMove(solution, neighbourhood, best_move.first, best_move.second);
+
+  return true;
+}  // bool LocalSearch::Explore(Solution& solution, Neighbourhood neighbourhood)
+
+/**
+ * Greedy path relinking. The attributes of \c guiding missing in the current solution are the task
+ * to VM and the dynamic file to storage assignments that differ; at each step every remaining
+ * attribute is applied, evaluated incrementally and undone, and the best one is kept. A file
+ * attribute that breaks a capacity or a hard conflict waits for a later step; the walk stops when
+ * no attribute can be applied. The best solution strictly between the two ends is returned.
+ *
+ * \param[in]   initial   The evaluated solution where the path starts
+ * \param[in]   guiding   The evaluated solution where the path ends
+ * \param[out]  best      The best intermediate solution, if any
+ * \retval      found     True if the path had an intermediate solution
+ */
+bool LocalSearch::PathRelinking(const Solution& initial, const Solution& guiding, Solution& best) {
+  std::vector<std::pair<Neighbourhood, size_t>> attributes;
+  Solution current = initial;
+  bool found = false;
+
+  current.PrepareIncrementalEvaluation();
+
+  for (size_t task_id = 0ul; task_id < algorithm_->GetTaskSize(); ++task_id) {
+    if (current.GetTaskAllocation(task_id) != guiding.GetTaskAllocation(task_id)) {
+      attributes.emplace_back(kMoveTask, task_id);
+    }
+  }
+
+  for (size_t file_id = 0ul; file_id < algorithm_->GetFileSize(); ++file_id) {
+    if (current.GetFileAllocation(file_id) != guiding.GetFileAllocation(file_id)
+        && current.GetFileAllocation(file_id) != std::numeric_limits<size_t>::max()) {
+      attributes.emplace_back(kMoveFile, file_id);
+    }
+  }
+
+  // The last attribute leads to the guiding solution itself
+  while (attributes.size() > 1ul && !algorithm_->IsTimeLimitReached()) {
+    const double makespan = current.get_makespan();
+    const double cost = current.get_cost();
+    double step_objective_value = std::numeric_limits<double>::max();
+    size_t step = attributes.size();
+
+    for (size_t i = 0ul; i < attributes.size(); ++i) {
+      Neighbourhood neighbourhood = attributes[i].first;
+      size_t a = attributes[i].second;
+      size_t b;
+      size_t reverse;
+
+      if (neighbourhood == kMoveTask) {
+        b = guiding.GetTaskAllocation(a);
+        reverse = current.GetTaskAllocation(a);
+      } else {
+        b = guiding.GetFileAllocation(a);
+        reverse = current.GetFileAllocation(a);
+
+        if (!current.CanMoveFile(a, b)) {
+          continue;
+        }
+      }
+
+      double objective_value = ApplyMove(current, neighbourhood, a, b);
+
+      ++evaluations_[neighbourhood];
+
+      if (objective_value < step_objective_value) {
+        step_objective_value = objective_value;
+        step = i;
+      }
+
+      ApplyMove(current, neighbourhood, a, reverse);
+      current.RestoreEvaluation(makespan, cost);
+    }
+
+    if (step == attributes.size()) {
+      break;  // No attribute can be applied
+    }
+
+    size_t a = attributes[step].second;
+
+    if (attributes[step].first == kMoveTask) {
+      ApplyMove(current, kMoveTask, a, guiding.GetTaskAllocation(a));
+    } else {
+      ApplyMove(current, kMoveFile, a, guiding.GetFileAllocation(a));
+    }
+
+    attributes[step] = attributes.back();
+    attributes.pop_back();
+
+    if (!found || current.get_objective_value() < best.get_objective_value()) {
+      best = current;
+      found = true;
+    }
+  }
+
+  return found;
+}  // bool LocalSearch::PathRelinking(...)
+
+/**
+ * The moves go through \c Solution::MoveTaskIncrementally() and
+ * \c Solution::MoveFileIncrementally(), so only the finish times that change are recomputed; a
+ * swap is two such moves.
+ *
+ * \param[in]  solution         The indexed solution to be changed
+ * \param[in]  neighbourhood    The neighbourhood of the move
+ * \param[in]  a                The task or file to be moved, or the first of the swapped ones
+ * \param[in]  b                The new VM or storage, or the second of the swapped ones
+ * \retval     objective_value  The objective value after the move
+ */
+double LocalSearch::ApplyMove(Solution& solution, Neighbourhood neighbourhood, size_t a, size_t b) {
+  switch (neighbourhood) {
+    case kMoveTask:
+      return solution.MoveTaskIncrementally(a, b);
+    case kSwapTasks: {
+      size_t vm_a = solution.GetTaskAllocation(a);
+
+      solution.MoveTaskIncrementally(a, solution.GetTaskAllocation(b));
+      return solution.MoveTaskIncrementally(b, vm_a);
+    }
+    case kMoveFile:
+      return solution.MoveFileIncrementally(a, b);
+    case kSwapFiles: {
+      size_t storage_a = solution.GetFileAllocation(a);
+
+      solution.MoveFileIncrementally(a, solution.GetFileAllocation(b));
+      return solution.MoveFileIncrementally(b, storage_a);
+    }
+    default:
+      LOG(FATAL) << "Invalid neighbourhood: " << static_cast<int>(neighbourhood);
+  }
+
+  return solution.get_objective_value();
+}  // double LocalSearch::ApplyMove(...)
+
+/**
+ * The source and the target tasks and the static files are never moved. The swaps are limited to
+ * pairs that compete for the resources at the same time: tasks of the same height at different
+ * VMs, and dynamic files written by tasks of the same height at different storages. The file
+ * moves and swaps keep the capacities and the hard conflicts, see \c Solution::CanMoveFile(). After
+ * \c Focus(), only the active tasks and files are moved.
+ *
+ * With \c critical_path_moves_, the moves of the tasks of the critical path (see
+ * \c Solution::GetCriticalPath()) and of the files they read or write are all kept; the finish
+ * time of any other task has a slack, so its moves are kept only if they lower its estimated cost
+ * and exposure (see \c EstimateTaskMove() and \c EstimateFileTerms()). A swap of two such tasks
+ * or files must lower the sum of their estimates. The path is extracted in linear time from the
+ * last evaluation of the indexed \c solution.
+ *
+ * \param[in]  solution       The current solution
+ * \param[in]  neighbourhood  The neighbourhood
+ * \retval     moves          The (a, b) pairs accepted by \c ApplyMove()
+ */
+std::vector<std::pair<size_t, size_t>> LocalSearch::GetMoves(const Solution& solution,
+                                                             Neighbourhood neighbourhood) {
+  std::vector<std::pair<size_t, size_t>> moves;
+  std::vector<int>& height = algorithm_->get_height();
+  std::vector<size_t> tasks;
+  std::vector<DynamicFile*> files;
+
+  if (critical_path_moves_) {
+    critical_tasks_.assign(algorithm_->GetTaskSize(), false);
+    critical_files_.assign(algorithm_->GetFileSize(), false);
+
+    for (size_t task_id : solution.GetCriticalPath()) {
+      Task* task = algorithm_->GetTaskPerId(task_id);
+
+      critical_tasks_[task_id] = true;
+
+      for (File* file : task->get_input_files()) {
+        critical_files_[file->get_id()] = true;
+      }
+
+      for (File* file : task->get_output_files()) {
+        critical_files_[file->get_id()] = true;
+      }
+    }
+  }
+
+  for (size_t task_id = 0ul; task_id < algorithm_->GetTaskSize(); ++task_id) {
+    if (task_id != algorithm_->get_id_source() && task_id != algorithm_->get_id_target()
+        && (!focused_ || active_tasks_[task_id])) {
+      tasks.push_back(task_id);
+    }
+  }
+
+  for (size_t file_id = 0ul; file_id < algorithm_->GetFileSize(); ++file_id) {
+    if (DynamicFile* file = dynamic_cast<DynamicFile*>(algorithm_->GetFilePerId(file_id))) {
+      if (file->get_parent_task() != nullptr && (!focused_ || active_files_[file_id])) {
+        files.push_back(file);
+      }
+    }
+  }
+
+  switch (neighbourhood) {
+    case kMoveTask:
+      for (size_t task_id : tasks) {
+        size_t current_vm_id = solution.GetTaskAllocation(task_id);
+        bool off_path = critical_path_moves_ && !critical_tasks_[task_id];
+
+        for (size_t vm_id = 0ul; vm_id < algorithm_->GetVirtualMachineSize(); ++vm_id) {
+          if (vm_id != current_vm_id
+              && (!off_path || EstimateTaskMove(solution, task_id, vm_id) < 0.0)) {
+            moves.emplace_back(task_id, vm_id);
+          }
+        }
+      }
+      break;
+    case kSwapTasks:
+      for (size_t i = 0ul; i < tasks.size(); ++i) {
+        for (size_t j = i + 1ul; j < tasks.size(); ++j) {
+          size_t vm_i = solution.GetTaskAllocation(tasks[i]);
+          size_t vm_j = solution.GetTaskAllocation(tasks[j]);
+
+          if (height[tasks[i]] != height[tasks[j]] || vm_i == vm_j) {
+            continue;
+          }
+
+          if (critical_path_moves_ && !critical_tasks_[tasks[i]] && !critical_tasks_[tasks[j]]
+              && EstimateTaskMove(solution, tasks[i], vm_j)
+                  + EstimateTaskMove(solution, tasks[j], vm_i) >= 0.0) {
+            continue;
+          }
+
+          moves.emplace_back(tasks[i], tasks[j]);
+        }
+      }
+      break;
+    case kMoveFile:
+      for (DynamicFile* file : files) {
+        size_t current_storage_id = solution.GetFileAllocation(file->get_id());
+        bool off_path = critical_path_moves_ && !critical_files_[file->get_id()];
+        double terms = off_path ? EstimateFileTerms(solution, file->get_id(), current_storage_id)
+                                : 0.0;
+
+        for (size_t storage_id = 0ul; storage_id < algorithm_->GetStorageSize(); ++storage_id) {
+          if (storage_id != current_storage_id
+              && solution.CanMoveFile(file->get_id(), storage_id)
+              && (!off_path || EstimateFileTerms(solution, file->get_id(), storage_id) < terms)) {
+            moves.emplace_back(file->get_id(), storage_id);
+          }
+        }
+      }
+      break;
+    case kSwapFiles:
+      for (size_t i = 0ul; i < files.size(); ++i) {
+        for (size_t j = i + 1ul; j < files.size(); ++j) {
+          size_t a = files[i]->get_id();
+          size_t b = files[j]->get_id();
+          size_t storage_a = solution.GetFileAllocation(a);
+          size_t storage_b = solution.GetFileAllocation(b);
+
+          if (height[files[i]->get_parent_task()->get_id()]
+                  != height[files[j]->get_parent_task()->get_id()]
+              || storage_a == storage_b
+              || !solution.CanMoveFile(a, storage_b, b)
+              || !solution.CanMoveFile(b, storage_a, a)) {
+            continue;
+          }
+
+          if (critical_path_moves_ && !critical_files_[a] && !critical_files_[b]
+              && EstimateFileTerms(solution, a, storage_b, b)
+                  + EstimateFileTerms(solution, b, storage_a, a)
+                  >= EstimateFileTerms(solution, a, storage_a, b)
+                  + EstimateFileTerms(solution, b, storage_b, a)) {
+            continue;
+          }
+
+          moves.emplace_back(a, b);
+        }
+      }
+      break;
+    default:
+      LOG(FATAL) << "Invalid neighbourhood: " << static_cast<int>(neighbourhood);
+  }
+
+  return moves;
+}  // std::vector<std::pair<size_t, size_t>> LocalSearch::GetMoves(...)
+
+/**
+ * The change of the cost of the two VM queues (see \c Solution::EstimateTaskMoveCost()) and of the
+ * exposure of the requirements of the task, weighted and normalised as in the objective value. The
+ * makespan is ignored: off the critical path, the task has a slack.
+ *
+ * \param[in]  solution  The current indexed solution
+ * \param[in]  task_id   The task
+ * \param[in]  vm_id     The candidate VM
+ * \retval     delta     The estimated change of the cost and exposure terms of the objective value
+ */
+double LocalSearch::EstimateTaskMove(const Solution& solution,
+                                     size_t task_id,
+                                     size_t vm_id) const {
+  Task* task = algorithm_->GetTaskPerId(task_id);
+  VirtualMachine* current_vm = algorithm_->GetVirtualMachinePerId(
+      solution.GetTaskAllocation(task_id));
+  VirtualMachine* virtual_machine = algorithm_->GetVirtualMachinePerId(vm_id);
+
+  return algorithm_->get_alpha_budget()
+             * (solution.EstimateTaskMoveCost(task_id, vm_id) / algorithm_->get_budget_max())
+         + algorithm_->get_alpha_security()
+             * ((solution.ComputeTaskSecurityExposure(task, virtual_machine)
+                 - solution.ComputeTaskSecurityExposure(task, current_vm))
+                / algorithm_->get_maximum_security_and_privacy_exposure());
+}  // double LocalSearch::EstimateTaskMove(...) const
+
+/**
+ * The bucket cost of the file, nothing at a VM, and the soft conflicts with the files already at
+ * the storage, weighted and normalised as in the objective value.
+ *
+ * \param[in]  solution         The current solution
+ * \param[in]  file_id          The file
+ * \param[in]  storage_id       The candidate storage
+ * \param[in]  ignored_file_id  A file whose conflict is not counted, as the other one of a swap
+ * \retval     terms            The estimated cost and exposure terms of the objective value
+ */
+double LocalSearch::EstimateFileTerms(const Solution& solution,
+                                      size_t file_id,
+                                      size_t storage_id,
+                                      size_t ignored_file_id) const {
+  File* file = algorithm_->GetFilePerId(file_id);
+  double cost = 0.0;
+  double exposure = 0.0;
+
+  if (storage_id >= algorithm_->GetVirtualMachineSize()) {
+    cost = algorithm_->GetStoragePerId(storage_id)->get_cost() * file->get_size_in_GB();
+  }
+
+  for (const auto& conflict : algorithm_->get_conflict_graph().GetConflicts(file_id)) {
+    if (conflict.second > 0 && conflict.first != ignored_file_id
+        && solution.GetFileAllocation(conflict.first) == storage_id) {
+      exposure += conflict.second;
+    }
+  }
+
+  return algorithm_->get_alpha_budget() * (cost / algorithm_->get_budget_max())
+         + algorithm_->get_alpha_security()
+             * (exposure / algorithm_->get_maximum_security_and_privacy_exposure());
+}  // double LocalSearch::EstimateFileTerms(...) const
+
+/**
+ * One line per neighbourhood that evaluated a move, with its totals over all the calls; printed to
+ * the standard output after the solution.
+ */
+void LocalSearch::ReportStatistics() const {
+  for (size_t k = 0ul; k < kNumberOfNeighbourhoods; ++k) {
+    if (evaluations_[k] == 0ul) {
+      continue;  // Neighbourhood not used
+    }
+
+    std::cout << "Local search " << kNeighbourhoodNames[k] << ": " << improvements_[k]
+        << " improvements, " << evaluations_[k] << " evaluations, " << time_[k] << " seconds"
+        << std::endl;
+  }
+}  // void LocalSearch::ReportStatistics() const
@@ -0,0 +1,131 @@
+/**
+ * \file src/solution/local_search.h
+ * \brief Contains the \c LocalSearch class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This header file contains the \c LocalSearch class that improves complete solutions.
+ */
+
+#ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_LOCAL_SEARCH_H_
+#define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_LOCAL_SEARCH_H_
+
+#include <array>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "src/solution/algorithm.h"
+#include "src/model/solution.h"
+
+/**
+ * \class LocalSearch local_search.h "src/solution/local_search.h"
+ * \brief Variable Neighbourhood Descent over the task and file allocations of a \c Solution
+ *
+ * The neighbourhoods are explored in the order of \c Neighbourhood; after an improvement the
+ * descent restarts from the first one, and it stops when no neighbourhood improves the solution.
+ * The \c --local_search flag selects the first or the best improvement strategy; the
+ * metaheuristics call \c Descent() over their own neighbourhoods whatever the flag. The number of
+ * improvements, of evaluated moves and the time spent are accumulated per neighbourhood over all
+ * the calls. With \c --critical_path_moves, the tasks and files off the critical path are moved
+ * only for their cost and exposure, since moving them cannot shorten the makespan.
+ */
+class LocalSearch {
+ public:
+  /// The neighbourhoods of the descent
+  enum Neighbourhood {
+    kMoveTask = 0,    ///< Move one task to another VM
+    kSwapTasks,       ///< Swap the VMs of two tasks of the same height
+    kMoveFile,        ///< Move one dynamic file to another storage
+    kSwapFiles,       ///< Swap the storages of two dynamic files written at the same height
+    kNumberOfNeighbourhoods
+  };
+
+  /// Parameterised constructor; reads the \c --local_search strategy
+  explicit LocalSearch(Algorithm* algorithm);
+
+  /// Default destructor
+  ~LocalSearch() = default;
+
+  /// Return false when \c --local_search is none
+  bool is_enabled() const { return enabled_; }
+
+  /// Improve the \c solution until it is a local optimum of every neighbourhood
+  double VariableNeighbourhoodDescent(Solution& solution);
+
+  /// Improve the evaluated \c solution until it is a local optimum of the \c neighbourhoods
+  double Descent(Solution& solution, const std::vector<Neighbourhood>& neighbourhoods);
+
+  /// Restrict the moves to the \c tasks and \c files, and to the tasks and files around them
+  void Focus(const std::vector<size_t>& tasks, const std::vector<size_t>& files);
+
+  /// Remove the restriction of \c Focus()
+  void ClearFocus() { focused_ = false; }
+
+  /// Explore the \c neighbourhood of the indexed \c solution once; return true if a move is applied
+  bool Explore(Solution& solution, Neighbourhood neighbourhood);
+
+  /// Apply the move (\c a, \c b) of the \c neighbourhood incrementally; return the objective value
+  double ApplyMove(Solution& solution, Neighbourhood neighbourhood, size_t a, size_t b);
+
+  /// Walk from \c initial toward \c guiding; store the best intermediate solution into \c best
+  bool PathRelinking(const Solution& initial, const Solution& guiding, Solution& best);
+
+  /// Return the feasible moves of the \c neighbourhood of the evaluated \c solution
+  std::vector<std::pair<size_t, size_t>> GetMoves(const Solution& solution,
+                                                  Neighbourhood neighbourhood);
+
+  /// Print the improvements, evaluations and time of each neighbourhood
+  void ReportStatistics() const;
+
+ private:
+  /// Estimate the weighted change of cost and exposure of moving the task \c task_id to \c vm_id
+  double EstimateTaskMove(const Solution& solution, size_t task_id, size_t vm_id) const;
+
+  /// Estimate the weighted cost and exposure of the file \c file_id at the storage \c storage_id
+  double EstimateFileTerms(const Solution& solution,
+                           size_t file_id,
+                           size_t storage_id,
+                           size_t ignored_file_id = std::numeric_limits<size_t>::max()) const;
+
+  /// The algorithm that holds the instance
+  Algorithm* algorithm_;
+
+  /// Whether the local search is applied
+  bool enabled_ = false;
+
+  /// Whether the best move of a neighbourhood is applied, instead of the first improving one
+  bool best_improvement_ = false;
+
+  /// Whether the moves are restricted to \c active_tasks_ and \c active_files_
+  bool focused_ = false;
+
+  /// Whether only the critical path is moved for the makespan; see \c --critical_path_moves
+  bool critical_path_moves_ = false;
+
+  /// Tasks of the critical path of the explored solution
+  std::vector<bool> critical_tasks_;
+
+  /// Files read or written by the tasks of the critical path of the explored solution
+  std::vector<bool> critical_files_;
+
+  /// Tasks that can be moved when \c focused_
+  std::vector<bool> active_tasks_;
+
+  /// Files that can be moved when \c focused_
+  std::vector<bool> active_files_;
+
+  /// Number of improving moves applied per neighbourhood
+  std::array<size_t, kNumberOfNeighbourhoods> improvements_{};
+
+  /// Number of evaluated moves per neighbourhood
+  std::array<size_t, kNumberOfNeighbourhoods> evaluations_{};
+
+  /// Seconds spent in each neighbourhood
+  std::array<double, kNumberOfNeighbourhoods> time_{};
+};  // end of class LocalSearch
+
+#endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_LOCAL_SEARCH_H_
@@ -0,0 +1,405 @@
+/**
+ * \file src/solution/memetic_algorithm.cc
+ * \brief Contains the \c MemeticAlgorithm class methods.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This source file contains the methods from the \c MemeticAlgorithm class that run the memetic
+ * algorithm.
+ */
+
+#include "src/solution/memetic_algorithm.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+DECLARE_uint64(number_of_threads);
+DECLARE_uint64(memetic_population_size);
+DECLARE_uint64(memetic_number_of_generations);
+DECLARE_double(memetic_mutation_rate);
+DECLARE_uint64(memetic_local_search_moves);
+
+/**
+ * The task move goes to any other VM; the file move goes to a random storage where the file fits
+ * (see \c Solution::CanMoveFile()). A move that cannot be drawn is returned as
+ * \c std::numeric_limits<size_t>::max().
+ *
+ * \param[in]   solution    The solution
+ * \param[in]   generator   The random number generator of the thread
+ * \param[out]  task_id     The task to be moved
+ * \param[out]  vm_id       The new VM of the task
+ * \param[out]  file_id     The file to be moved
+ * \param[out]  storage_id  The new storage of the file
+ */
+void MemeticAlgorithm::DrawMoves(const Solution& solution,
+                                 std::mt19937& generator,
+                                 size_t& task_id,
+                                 size_t& vm_id,
+                                 size_t& file_id,
+                                 size_t& storage_id) {
+  task_id = vm_id = file_id = storage_id = std::numeric_limits<size_t>::max();
+
+  if (GetVirtualMachineSize() > 1ul) {
+    // Any task but the source and the target ones
+    task_id = 1ul + generator() % (GetTaskSize() - 2ul);
+    vm_id = generator() % (GetVirtualMachineSize() - 1ul);
+
+    if (vm_id >= solution.GetTaskAllocation(task_id)) {
+      ++vm_id;  // Skip the current VM
+    }
+  }
+
+  if (dynamic_file_size_ > 0ul) {
+    size_t file = static_file_size_ + generator() % dynamic_file_size_;
+    size_t storage = generator() % GetStorageSize();
+
+    // A dynamic file without a producer is never stored
+    if (solution.GetFileAllocation(file) != std::numeric_limits<size_t>::max()
+        && solution.GetFileAllocation(file) != storage && solution.CanMoveFile(file, storage)) {
+      file_id = file;
+      storage_id = storage;
+    }
+  }
+}  // void MemeticAlgorithm::DrawMoves(...)
+
+/**
+ * Kahn's algorithm with a random ready task at each step.
+ *
+ * \param[in]  solution   The solution whose ordering is replaced
+ * \param[in]  generator  The random number generator
+ */
+void MemeticAlgorithm::ShuffleOrdering(Solution& solution, std::mt19937& generator) {
+  std::vector<size_t> in_degree(GetTaskSize());
+  std::vector<size_t> ready;
+
+  for (size_t task_id = 0ul; task_id < GetTaskSize(); ++task_id) {
+    in_degree[task_id] = GetPredecessors(task_id).size();
+
+    if (in_degree[task_id] == 0ul) {
+      ready.push_back(task_id);
+    }
+  }
+
+  for (size_t position = 0ul; !ready.empty(); ++position) {
+    size_t chosen = generator() % ready.size();
+    size_t task_id = ready[chosen];
+
+    ready[chosen] = ready.back();
+    ready.pop_back();
+    solution.SetOrdering(position, task_id);
+
+    for (size_t successor_id : GetSuccessors(task_id)) {
+      if (--in_degree[successor_id] == 0ul) {
+        ready.push_back(successor_id);
+      }
+    }
+  }
+}  // void MemeticAlgorithm::ShuffleOrdering(Solution& solution, std::mt19937& generator)
+
+/**
+ * The offspring keeps the first \c k tasks of the ordering of \c first, with their VMs and their
+ * output files, and takes the other tasks in the relative order of \c second, with the VMs and the
+ * output files of \c second. Both parts are topological, so the offspring ordering is too. An
+ * output file of \c second that does not fit stays where \c first put it.
+ *
+ * \param[in]  first      The first parent
+ * \param[in]  second     The second parent
+ * \param[in]  offspring  The slot that receives the offspring
+ * \param[in]  buffer     The buffers of the thread
+ */
+void MemeticAlgorithm::Crossover(const Solution& first,
+                                 const Solution& second,
+                                 Solution& offspring,
+                                 ThreadBuffer& buffer) {
+  const std::vector<size_t>& first_ordering = first.get_ordering();
+  const std::vector<size_t>& second_ordering = second.get_ordering();
+  size_t position = 1ul + buffer.generator() % (first_ordering.size() - 1ul);
+
+  offspring = first;
+  buffer.taken.assign(GetTaskSize(), false);
+
+  for (size_t i = 0ul; i < position; ++i) {
+    buffer.taken[first_ordering[i]] = true;
+  }
+
+  for (size_t task_id : second_ordering) {
+    if (buffer.taken[task_id]) {
+      continue;
+    }
+
+    offspring.SetOrdering(position++, task_id);
+
+    if (task_id == id_source_ || task_id == id_target_) {
+      continue;
+    }
+
+    if (offspring.GetTaskAllocation(task_id) != second.GetTaskAllocation(task_id)) {
+      offspring.MoveTask(task_id, second.GetTaskAllocation(task_id), false);
+    }
+
+    for (File* file : GetTaskPerId(task_id)->get_output_files()) {
+      size_t storage_id = second.GetFileAllocation(file->get_id());
+
+      if (storage_id != offspring.GetFileAllocation(file->get_id())
+          && offspring.CanMoveFile(file->get_id(), storage_id)) {
+        offspring.MoveFile(file->get_id(), storage_id, false);
+      }
+    }
+  }
+}  // void MemeticAlgorithm::Crossover(...)
+
+/**
+ * The shifted task goes to a random position between its last predecessor and its first
+ * successor in the ordering, which stays topological.
+ *
+ * \param[in]  solution  The solution to be mutated
+ * \param[in]  buffer    The buffers of the thread
+ */
+void MemeticAlgorithm::Mutate(Solution& solution, ThreadBuffer& buffer) {
+  size_t task_id, vm_id, file_id, storage_id;
+
+  DrawMoves(solution, buffer.generator, task_id, vm_id, file_id, storage_id);
+
+  if (task_id != std::numeric_limits<size_t>::max()) {
+    solution.MoveTask(task_id, vm_id, false);
+  }
+
+  if (file_id != std::numeric_limits<size_t>::max()) {
+    solution.MoveFile(file_id, storage_id, false);
+  }
+
+  const std::vector<size_t>& ordering = solution.get_ordering();
+
+  buffer.position.resize(ordering.size());
+
+  for (size_t i = 0ul; i < ordering.size(); ++i) {
+    buffer.position[ordering[i]] = i;
+  }
+
+  task_id = 1ul + buffer.generator() % (GetTaskSize() - 2ul);
+
+  size_t current = buffer.position[task_id];
+  size_t lowest = 0ul;
+  size_t highest = ordering.size() - 1ul;
+
+  for (size_t predecessor_id : GetPredecessors(task_id)) {
+    lowest = std::max(lowest, buffer.position[predecessor_id] + 1ul);
+  }
+
+  for (size_t successor_id : GetSuccessors(task_id)) {
+    highest = std::min(highest, buffer.position[successor_id] - 1ul);
+  }
+
+  size_t target = lowest + buffer.generator() % (highest - lowest + 1ul);
+
+  for (; current > target; --current) {
+    solution.SetOrdering(current, ordering[current - 1ul]);
+  }
+
+  for (; current < target; ++current) {
+    solution.SetOrdering(current, ordering[current + 1ul]);
+  }
+
+  solution.SetOrdering(target, task_id);
+}  // void MemeticAlgorithm::Mutate(Solution& solution, ThreadBuffer& buffer)
+
+/**
+ * Task and file moves alternate; a move that does not improve the evaluated \c solution is undone
+ * without a replay (see \c Solution::RestoreEvaluation()).
+ *
+ * \param[in]  solution  The evaluated solution to be improved
+ * \param[in]  buffer    The buffers of the thread
+ */
+void MemeticAlgorithm::ImproveLocally(Solution& solution, ThreadBuffer& buffer) {
+  size_t task_id, vm_id, file_id, storage_id;
+
+  for (size_t i = 0ul; i < FLAGS_memetic_local_search_moves; ++i) {
+    double objective_value = solution.get_objective_value();
+    double makespan = solution.get_makespan();
+    double cost = solution.get_cost();
+
+    DrawMoves(solution, buffer.generator, task_id, vm_id, file_id, storage_id);
+
+    if (i % 2ul == 0ul && task_id != std::numeric_limits<size_t>::max()) {
+      size_t old_vm_id = solution.GetTaskAllocation(task_id);
+
+      if (solution.MoveTask(task_id, vm_id) >= objective_value) {
+        solution.MoveTask(task_id, old_vm_id, false);
+        solution.RestoreEvaluation(makespan, cost);
+      }
+    } else if (i % 2ul == 1ul && file_id != std::numeric_limits<size_t>::max()) {
+      size_t old_storage_id = solution.GetFileAllocation(file_id);
+
+      if (solution.MoveFile(file_id, storage_id) >= objective_value) {
+        solution.MoveFile(file_id, old_storage_id, false);
+        solution.RestoreEvaluation(makespan, cost);
+      }
+    }
+  }
+}  // void MemeticAlgorithm::ImproveLocally(Solution& solution, ThreadBuffer& buffer)
+
+/**
+ * The first individual is the HEFT solution; the others take a random topological ordering and
+ * have a fifth of their tasks, and as many files, moved at random. Every slot of the \c pool, the
+ * offspring ones too, is initialised with the HEFT solution, so the later copies reuse its
+ * buffers.
+ *
+ * \param[in]  pool             The population and offspring slots
+ * \param[in]  population_size  The number of individuals
+ * \param[in]  generator        The random number generator
+ */
+void MemeticAlgorithm::InitialisePopulation(std::vector<Solution>& pool,
+                                            size_t population_size,
+                                            std::mt19937& generator) {
+  ConstructInitialSolution(pool[0]);
+
+  for (size_t i = 1ul; i < pool.size(); ++i) {
+    pool[i] = pool[0];
+  }
+
+  for (size_t i = 1ul; i < population_size; ++i) {
+    ShuffleOrdering(pool[i], generator);
+
+    for (size_t j = 0ul; j < GetTaskSize() / 5ul; ++j) {
+      size_t task_id, vm_id, file_id, storage_id;
+
+      DrawMoves(pool[i], generator, task_id, vm_id, file_id, storage_id);
+
+      if (task_id != std::numeric_limits<size_t>::max()) {
+        pool[i].MoveTask(task_id, vm_id, false);
+      }
+
+      if (file_id != std::numeric_limits<size_t>::max()) {
+        pool[i].MoveFile(file_id, storage_id, false);
+      }
+    }
+
+    pool[i].Evaluate();
+  }
+}  // void MemeticAlgorithm::InitialisePopulation(...)
+
+/**
+ * The population and the offspring share one vector of \c 2P solutions, allocated at the start;
+ * the offspring overwrite the last \c P slots, and sorting the vector by objective value moves the
+ * survivors to the first \c P slots. An individual with the objective value of the previous
+ * survivor is taken as a duplicate and sent after the others, to keep the population diverse.
+ */
+void MemeticAlgorithm::Run() {
+  DLOG(INFO) << "Executing Memetic Algorithm...";
+
+  const size_t population_size = FLAGS_memetic_population_size;
+  const size_t number_of_threads = std::max<size_t>(FLAGS_number_of_threads, 1ul);
+
+  if (population_size < 2ul) {
+    LOG(FATAL) << "The population needs at least two individuals: " << population_size;
+  }
+
+  std::mt19937 generator(static_cast<std::mt19937::result_type>(rand()));
+  std::vector<ThreadBuffer> buffers(number_of_threads);
+
+  for (ThreadBuffer& buffer : buffers) {
+    buffer.generator.seed(static_cast<std::mt19937::result_type>(rand()));
+  }
+
+  std::vector<Solution> pool(2ul * population_size, Solution(this));
+
+  InitialisePopulation(pool, population_size, generator);
+
+  auto by_objective_value = [](const Solution& a, const Solution& b) {
+    return a.get_objective_value() < b.get_objective_value();
+  };
+
+  std::sort(pool.begin(), pool.begin() + static_cast<long>(population_size), by_objective_value);
+
+  ReportIncumbent(pool[0]);
+
+  std::vector<std::pair<size_t, size_t>> parents(population_size);
+  size_t number_of_improvements = 0ul;
+  size_t generation = 0ul;
+
+  // Binary tournament among the population
+  auto select = [&]() {
+    size_t a = static_cast<size_t>(rand()) % population_size;
+    size_t b = static_cast<size_t>(rand()) % population_size;
+
+    return std::min(a, b);  // The population is sorted
+  };
+
+  for (; generation < FLAGS_memetic_number_of_generations && !IsTimeLimitReached(); ++generation) {
+    double best_objective_value = pool[0].get_objective_value();
+
+    for (std::pair<size_t, size_t>& pair : parents) {
+      pair.first = select();
+      pair.second = select();
+    }
+
+    std::vector<std::thread> threads;
+    size_t thread_size = std::min(number_of_threads, population_size);
+
+    auto breed = [&](size_t first) {
+      ThreadBuffer& buffer = buffers[first];
+
+      for (size_t i = first; i < population_size; i += thread_size) {
+        Solution& offspring = pool[population_size + i];
+
+        Crossover(pool[parents[i].first], pool[parents[i].second], offspring, buffer);
+
+        if (std::generate_canonical<double, 32>(buffer.generator) < FLAGS_memetic_mutation_rate) {
+          Mutate(offspring, buffer);
+        }
+
+        offspring.Evaluate();
+        ImproveLocally(offspring, buffer);
+      }
+    };
+
+    for (size_t t = 1ul; t < thread_size; ++t) {
+      threads.emplace_back(breed, t);
+    }
+
+    breed(0ul);
+
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    std::sort(pool.begin(), pool.end(), by_objective_value);
+
+    // Send the duplicates after the distinct individuals
+    size_t distinct = 1ul;
+
+    for (size_t i = 1ul; i < pool.size(); ++i) {
+      if (pool[i].get_objective_value() != pool[distinct - 1ul].get_objective_value()) {
+        std::swap(pool[distinct++], pool[i]);
+      }
+    }
+
+    if (pool[0].get_objective_value() < best_objective_value) {
+      ++number_of_improvements;
+      ReportIncumbent(pool[0]);
+    }
+  }
+
+  Solution& best_solution = pool[0];
+
+  // The local moves kept the exposure by deltas (see ImproveLocally()); recompute every value
+  best_solution.ObjectiveFunction(false, false);
+
+  ReportSolution(best_solution);
+  std::cout << "Memetic algorithm: " << generation << " generations, "
+      << generation * population_size << " offspring, " << number_of_improvements
+      << " generations improved the best solution" << std::endl;
+
+  DLOG(INFO) << "... ending Memetic Algorithm";
+}  // end of MemeticAlgorithm::Run() method
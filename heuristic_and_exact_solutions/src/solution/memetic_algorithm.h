@@ -0,0 +1,85 @@
+/**
+ * \file src/solution/memetic_algorithm.h
+ * \brief Contains the \c MemeticAlgorithm class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This header file contains the \c MemeticAlgorithm class that evolves a population of solutions
+ * with crossover, mutation and a short local search.
+ */
+
+#ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_MEMETIC_ALGORITHM_H_
+#define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_MEMETIC_ALGORITHM_H_
+
+#include <random>
+#include <vector>
+
+#include "src/solution/algorithm.h"
+
+/**
+ * \class MemeticAlgorithm memetic_algorithm.h "src/solution/memetic_algorithm.h"
+ * \brief Genetic algorithm with local search over the allocations and the task ordering
+ *
+ * The chromosome is a \c Solution: the task allocations, the file allocations and the topological
+ * order in which the tasks are replayed. The first individual is the HEFT solution (see
+ * \c Algorithm::ConstructGreedySolution()); the others are random variations of it. Each
+ * generation breeds \c --memetic_population_size offspring from tournament-selected parents, and
+ * the best individuals among the parents and the offspring survive. The search stops after
+ * \c --memetic_number_of_generations generations or at the time limit.
+ *
+ * The offspring are bred, mutated, improved and evaluated over \c --number_of_threads threads. The
+ * offspring slots and the buffers of each thread are allocated once and reused by every
+ * generation.
+ */
+class MemeticAlgorithm : public Algorithm {
+ public:
+  /// Default constructor
+  MemeticAlgorithm() = default;
+
+  /// Default destructor
+  ~MemeticAlgorithm() = default;
+
+  /// Evolve the population; print the best solution
+  void Run(void);
+
+ protected:
+  /// Buffers owned by one thread, reused between the offspring and the generations
+  struct ThreadBuffer {
+    std::mt19937 generator;
+    std::vector<bool> taken;
+    std::vector<size_t> position;
+  };
+
+  /// Fill the first \c population_size slots of \c pool with the HEFT solution and variations
+  void InitialisePopulation(std::vector<Solution>& pool,
+                            size_t population_size,
+                            std::mt19937& generator);
+
+  /// Breed \c offspring from \c first and \c second with a crossover at a cut of the ordering
+  void Crossover(const Solution& first,
+                 const Solution& second,
+                 Solution& offspring,
+                 ThreadBuffer& buffer);
+
+  /// Move a random task to a random VM, a random file to a random storage, and shift a random task
+  void Mutate(Solution& solution, ThreadBuffer& buffer);
+
+  /// Try \c --memetic_local_search_moves random task and file moves; keep the improving ones
+  void ImproveLocally(Solution& solution, ThreadBuffer& buffer);
+
+  /// Replace the ordering of \c solution by a random topological order of the tasks
+  void ShuffleOrdering(Solution& solution, std::mt19937& generator);
+
+  /// Draw a random task move and a feasible random file move of \c solution, or none
+  void DrawMoves(const Solution& solution,
+                 std::mt19937& generator,
+                 size_t& task_id,
+                 size_t& vm_id,
+                 size_t& file_id,
+                 size_t& storage_id);
+};  // end of class MemeticAlgorithm
+
+#endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_MEMETIC_ALGORITHM_H_
@@ -24,6 +24,7 @@
 
 #include "src/model/static_file.h"
 #include "src/model/storage.h"
+#include "src/solution/local_search.h"
 
 /**
  * Do the scheduling
@@ -47,7 +48,7 @@ void MinMinAlgorithm::ScheduleAvailTasks(std::list<Task*> avail_tasks, Solution&
       double min_objective_function = std::numeric_limits<double>::max();
       size_t min_vm_id = 0;
 
-      for (VirtualMachine* vm : virtual_machines_) {
+      for (VirtualMachine* vm : GetProbeCandidates(task, solution)) {
         Solution new_solution = solution;
 
         double objective_value = new_solution.ScheduleTask(task, vm);
@@ -145,7 +146,17 @@ void MinMinAlgorithm::Run() {
 
   solution.ObjectiveFunction(false, false);
 
+  ReportIncumbent(solution);
+
+  LocalSearch local_search(this);
+
+  if (local_search.is_enabled()) {
+    local_search.VariableNeighbourhoodDescent(solution);
+    ReportIncumbent(solution);
+  }
+
   LOG(INFO) << solution;
   std::cout << solution;
+  local_search.ReportStatistics();
   DLOG(INFO) << "... ending MinMin algorithm";
 }  // end of MinMin::run() method
@@ -0,0 +1,404 @@
+/**
+ * \file src/solution/nsga2_algorithm.cc
+ * \brief Contains the \c Nsga2Algorithm class methods.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This source file contains the methods from the \c Nsga2Algorithm class that run the NSGA-II.
+ */
+
+#include "src/solution/nsga2_algorithm.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+DECLARE_uint64(number_of_threads);
+// The population flags are shared with the memetic algorithm
+DECLARE_uint64(memetic_population_size);
+DECLARE_uint64(memetic_number_of_generations);
+DECLARE_double(memetic_mutation_rate);
+DECLARE_uint64(pareto_archive_size);
+DECLARE_string(pareto_front_file);
+
+/// The objectives of a solution, all minimised
+static inline std::array<double, 3> GetObjectives(const Solution& solution) {
+  return {solution.get_makespan(), solution.get_cost(), solution.get_security_exposure()};
+}
+
+/**
+ * \param[in]  a          A solution
+ * \param[in]  b          Another solution
+ * \retval     dominates  True if \c a dominates \c b
+ */
+bool Nsga2Algorithm::Dominates(const Solution& a, const Solution& b) {
+  std::array<double, 3> objectives_a = GetObjectives(a);
+  std::array<double, 3> objectives_b = GetObjectives(b);
+  bool better = false;
+
+  for (size_t k = 0ul; k < objectives_a.size(); ++k) {
+    if (objectives_a[k] > objectives_b[k]) {
+      return false;
+    }
+
+    better = better || objectives_a[k] < objectives_b[k];
+  }
+
+  return better;
+}  // bool Nsga2Algorithm::Dominates(const Solution& a, const Solution& b)
+
+/**
+ * The fast non-dominated sorting of Deb et al.: each member counts the members that dominate it
+ * and lists the ones it dominates; the members with no dominator form the first front, and
+ * removing a front releases the next one.
+ *
+ * \param[in]   pool     The solutions
+ * \param[in]   members  The indices, into \c pool, of the solutions to be sorted
+ * \param[out]  rank     The front of each member, indexed like \c pool
+ * \retval      fronts   The indices, into \c pool, of the members of each front
+ */
+std::vector<std::vector<size_t>> Nsga2Algorithm::SortNonDominated(
+    const std::vector<Solution>& pool,
+    const std::vector<size_t>& members,
+    std::vector<size_t>& rank) {
+  std::vector<std::vector<size_t>> dominated(pool.size());
+  std::vector<size_t> domination_count(pool.size(), 0ul);
+  std::vector<std::vector<size_t>> fronts(1);
+
+  for (size_t p : members) {
+    for (size_t q : members) {
+      if (Dominates(pool[p], pool[q])) {
+        dominated[p].push_back(q);
+      } else if (Dominates(pool[q], pool[p])) {
+        ++domination_count[p];
+      }
+    }
+
+    if (domination_count[p] == 0ul) {
+      rank[p] = 0ul;
+      fronts[0].push_back(p);
+    }
+  }
+
+  for (size_t i = 0ul; !fronts[i].empty(); ++i) {
+    std::vector<size_t> next_front;
+
+    for (size_t p : fronts[i]) {
+      for (size_t q : dominated[p]) {
+        if (--domination_count[q] == 0ul) {
+          rank[q] = i + 1ul;
+          next_front.push_back(q);
+        }
+      }
+    }
+
+    fronts.push_back(std::move(next_front));
+  }
+
+  fronts.pop_back();  // The empty front
+
+  return fronts;
+}  // std::vector<std::vector<size_t>> Nsga2Algorithm::SortNonDominated(...)
+
+/**
+ * For each objective, the members are sorted; the extreme ones get an infinite distance and the
+ * others add the normalised gap between their two neighbours.
+ *
+ * \param[in]   pool      The solutions
+ * \param[in]   front     The indices, into \c pool, of the members of one front
+ * \param[out]  distance  The crowding distance of each member, indexed like \c pool
+ */
+void Nsga2Algorithm::ComputeCrowdingDistance(const std::vector<Solution>& pool,
+                                             const std::vector<size_t>& front,
+                                             std::vector<double>& distance) {
+  std::vector<size_t> sorted(front);
+
+  for (size_t p : front) {
+    distance[p] = 0.0;
+  }
+
+  for (size_t k = 0ul; k < 3ul; ++k) {
+    std::sort(sorted.begin(), sorted.end(), [&](size_t a, size_t b) {
+      return GetObjectives(pool[a])[k] < GetObjectives(pool[b])[k];
+    });
+
+    double minimum = GetObjectives(pool[sorted.front()])[k];
+    double range = GetObjectives(pool[sorted.back()])[k] - minimum;
+
+    distance[sorted.front()] = distance[sorted.back()] = std::numeric_limits<double>::max();
+
+    if (range <= 0.0) {
+      continue;
+    }
+
+    for (size_t i = 1ul; i + 1ul < sorted.size(); ++i) {
+      if (distance[sorted[i]] != std::numeric_limits<double>::max()) {
+        distance[sorted[i]] += (GetObjectives(pool[sorted[i + 1ul]])[k]
+                                - GetObjectives(pool[sorted[i - 1ul]])[k]) / range;
+      }
+    }
+  }
+}  // void Nsga2Algorithm::ComputeCrowdingDistance(...)
+
+/**
+ * The archived solutions dominated by the new one are removed. When the archive exceeds
+ * \c --pareto_archive_size, the member with the smallest crowding distance is dropped. The best
+ * member of each objective is never dropped; the archive holds at least four members then, so
+ * another one is. The members at the other ends of the front have an infinite distance too, so
+ * they are dropped only when every unprotected member is at an end.
+ *
+ * \param[in]  solution  An evaluated solution
+ */
+void Nsga2Algorithm::UpdateArchive(const Solution& solution) {
+  for (const Solution& member : archive_) {
+    if (Dominates(member, solution) || GetObjectives(member) == GetObjectives(solution)) {
+      return;
+    }
+  }
+
+  archive_.erase(std::remove_if(archive_.begin(), archive_.end(), [&](const Solution& member) {
+                   return Dominates(solution, member);
+                 }), archive_.end());
+  archive_.push_back(solution);
+
+  if (archive_.size() > FLAGS_pareto_archive_size) {
+    std::vector<size_t> members(archive_.size());
+    std::vector<double> distance(archive_.size());
+
+    for (size_t i = 0ul; i < members.size(); ++i) {
+      members[i] = i;
+    }
+
+    ComputeCrowdingDistance(archive_, members, distance);
+
+    std::vector<bool> best_of_objective(archive_.size(), false);
+
+    for (size_t k = 0ul; k < 3ul; ++k) {
+      best_of_objective[*std::min_element(members.begin(), members.end(), [&](size_t a, size_t b) {
+        return GetObjectives(archive_[a])[k] < GetObjectives(archive_[b])[k];
+      })] = true;
+    }
+
+    size_t most_crowded = archive_.size();
+
+    for (size_t i = 0ul; i < archive_.size(); ++i) {
+      if (!best_of_objective[i]
+          && (most_crowded == archive_.size() || distance[i] < distance[most_crowded])) {
+        most_crowded = i;
+      }
+    }
+
+    archive_.erase(archive_.begin() + static_cast<long>(most_crowded));
+  }
+}  // void Nsga2Algorithm::UpdateArchive(const Solution& solution)
+
+/**
+ * The population is a list of indices into the vector of \c 2P solutions; the other \c P slots
+ * receive the offspring, so the survivors are never copied.
+ */
+void Nsga2Algorithm::Run() {
+  DLOG(INFO) << "Executing NSGA-II...";
+
+  const size_t population_size = FLAGS_memetic_population_size;
+  const size_t number_of_threads = std::max<size_t>(FLAGS_number_of_threads, 1ul);
+
+  if (population_size < 4ul) {
+    LOG(FATAL) << "The population needs at least four individuals: " << population_size;
+  }
+
+  if (FLAGS_pareto_archive_size < 3ul) {
+    LOG(FATAL) << "The Pareto archive needs at least three solutions, the best of each objective: "
+        << FLAGS_pareto_archive_size;
+  }
+
+  archive_.clear();
+
+  std::mt19937 generator(static_cast<std::mt19937::result_type>(rand()));
+  std::vector<ThreadBuffer> buffers(number_of_threads);
+
+  for (ThreadBuffer& buffer : buffers) {
+    buffer.generator.seed(static_cast<std::mt19937::result_type>(rand()));
+  }
+
+  std::vector<Solution> pool(2ul * population_size, Solution(this));
+
+  InitialisePopulation(pool, population_size, generator);
+
+  // The HEFT solutions for each objective alone
+  const double alpha_time = alpha_time_;
+  const double alpha_budget = alpha_budget_;
+  const double alpha_security = alpha_security_;
+  const double weights[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+
+  for (size_t k = 0ul; k < 3ul; ++k) {
+    pool[k + 1ul] = Solution(this);
+    SetAlphas(weights[k][0], weights[k][1], weights[k][2], alpha_restrict_candidate_list_);
+    ConstructGreedySolution(pool[k + 1ul]);
+  }
+
+  SetAlphas(alpha_time, alpha_budget, alpha_security, alpha_restrict_candidate_list_);
+
+  std::vector<size_t> population(population_size);
+  std::vector<size_t> offspring(population_size);
+  std::vector<size_t> rank(pool.size(), 0ul);
+  std::vector<double> distance(pool.size(), 0.0);
+
+  for (size_t i = 0ul; i < population_size; ++i) {
+    pool[i].Evaluate();  // The objective value for the --alpha_* weights
+    UpdateArchive(pool[i]);
+    population[i] = i;
+    offspring[i] = population_size + i;
+  }
+
+  for (const std::vector<size_t>& front : SortNonDominated(pool, population, rank)) {
+    ComputeCrowdingDistance(pool, front, distance);
+  }
+
+  std::vector<std::pair<size_t, size_t>> parents(population_size);
+  size_t generation = 0ul;
+
+  // Binary tournament by rank, then by crowding distance
+  auto select = [&]() {
+    size_t a = population[static_cast<size_t>(rand()) % population_size];
+    size_t b = population[static_cast<size_t>(rand()) % population_size];
+
+    if (rank[a] != rank[b]) {
+      return rank[a] < rank[b] ? a : b;
+    }
+
+    return distance[a] >= distance[b] ? a : b;
+  };
+
+  for (; generation < FLAGS_memetic_number_of_generations && !IsTimeLimitReached(); ++generation) {
+    for (std::pair<size_t, size_t>& pair : parents) {
+      pair.first = select();
+      pair.second = select();
+    }
+
+    std::vector<std::thread> threads;
+    size_t thread_size = std::min(number_of_threads, population_size);
+
+    auto breed = [&](size_t first) {
+      ThreadBuffer& buffer = buffers[first];
+
+      for (size_t i = first; i < population_size; i += thread_size) {
+        Solution& child = pool[offspring[i]];
+
+        Crossover(pool[parents[i].first], pool[parents[i].second], child, buffer);
+
+        if (std::generate_canonical<double, 32>(buffer.generator) < FLAGS_memetic_mutation_rate) {
+          Mutate(child, buffer);
+        }
+
+        child.Evaluate();
+      }
+    };
+
+    for (size_t t = 1ul; t < thread_size; ++t) {
+      threads.emplace_back(breed, t);
+    }
+
+    breed(0ul);
+
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    for (size_t i : offspring) {
+      UpdateArchive(pool[i]);
+    }
+
+    // Survival: whole fronts while they fit, then the least crowded members of the next one
+    std::vector<size_t> members(population);
+
+    members.insert(members.end(), offspring.begin(), offspring.end());
+    population.clear();
+
+    for (std::vector<size_t>& front : SortNonDominated(pool, members, rank)) {
+      ComputeCrowdingDistance(pool, front, distance);
+
+      if (population.size() + front.size() > population_size) {
+        std::sort(front.begin(), front.end(), [&](size_t a, size_t b) {
+          return distance[a] > distance[b];
+        });
+        front.resize(population_size - population.size());
+      }
+
+      population.insert(population.end(), front.begin(), front.end());
+
+      if (population.size() == population_size) {
+        break;
+      }
+    }
+
+    // The slots left out receive the next offspring
+    std::vector<bool> survivor(pool.size(), false);
+
+    offspring.clear();
+
+    for (size_t i : population) {
+      survivor[i] = true;
+    }
+
+    for (size_t i : members) {
+      if (!survivor[i]) {
+        offspring.push_back(i);
+      }
+    }
+  }
+
+  std::sort(archive_.begin(), archive_.end(), [](const Solution& a, const Solution& b) {
+    return GetObjectives(a) < GetObjectives(b);
+  });
+
+  const Solution& best_solution = *std::min_element(
+      archive_.begin(), archive_.end(), [](const Solution& a, const Solution& b) {
+        return a.get_objective_value() < b.get_objective_value();
+      });
+
+  ReportIncumbent(best_solution);
+
+  ReportSolution(best_solution);
+  std::cout << "Pareto front: " << archive_.size() << " non-dominated solutions after "
+      << generation << " generations; makespan_max " << get_makespan_max() << ", budget_max "
+      << get_budget_max() << ", maximum security exposure "
+      << get_maximum_security_and_privacy_exposure() << std::endl;
+
+  for (const Solution& member : archive_) {
+    std::cout << "pareto " << member.get_makespan() << " " << member.get_cost() << " "
+        << member.get_security_exposure() << " " << member.get_objective_value() << std::endl;
+  }
+
+  if (!FLAGS_pareto_front_file.empty()) {
+    std::ofstream out_front(FLAGS_pareto_front_file);
+
+    out_front << std::setprecision(17)
+        << "# makespan_max " << get_makespan_max() << " budget_max " << get_budget_max()
+        << " maximum_security_exposure " << get_maximum_security_and_privacy_exposure()
+        << std::endl << "makespan,cost,security_exposure" << std::endl;
+
+    for (const Solution& member : archive_) {
+      out_front << member.get_makespan() << "," << member.get_cost() << ","
+          << member.get_security_exposure() << std::endl;
+    }
+
+    if (out_front.fail()) {
+      LOG(FATAL) << "Could not write the Pareto front to " << FLAGS_pareto_front_file;
+    }
+  }
+
+  DLOG(INFO) << "... ending NSGA-II";
+}  // end of Nsga2Algorithm::Run() method
@@ -0,0 +1,70 @@
+/**
+ * \file src/solution/nsga2_algorithm.h
+ * \brief Contains the \c Nsga2Algorithm class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This header file contains the \c Nsga2Algorithm class that approximates the Pareto front of the
+ * makespan, the cost and the security exposure in a single run.
+ */
+
+#ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_NSGA2_ALGORITHM_H_
+#define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_NSGA2_ALGORITHM_H_
+
+#include <vector>
+
+#include "src/solution/memetic_algorithm.h"
+
+/**
+ * \class Nsga2Algorithm nsga2_algorithm.h "src/solution/nsga2_algorithm.h"
+ * \brief NSGA-II over the makespan, the cost and the security exposure
+ *
+ * The chromosome, the crossover and the mutation are the ones of the \c MemeticAlgorithm, as are
+ * the \c --memetic_population_size, \c --memetic_number_of_generations and
+ * \c --memetic_mutation_rate flags; the offspring are not improved by a local search, which would
+ * need a weighted objective. Besides the HEFT solution and its variations, the initial population
+ * holds the HEFT solutions for the time, the budget and the security alone.
+ *
+ * The survivors are chosen by the fast non-dominated sorting and the crowding distance. Every
+ * evaluated solution is offered to an archive of at most \c --pareto_archive_size non-dominated
+ * solutions, whose most crowded member is dropped when it is full. The archive is printed, and
+ * written to \c --pareto_front_file if set, with the normalisation constants, so any weighted-sum
+ * optimum can be read off it; the best archived solution for the \c --alpha_* weights is printed
+ * as the solution of the run.
+ */
+class Nsga2Algorithm : public MemeticAlgorithm {
+ public:
+  /// Default constructor
+  Nsga2Algorithm() = default;
+
+  /// Default destructor
+  ~Nsga2Algorithm() = default;
+
+  /// Evolve the population; print the non-dominated archive and the best weighted solution
+  void Run(void);
+
+ private:
+  /// Return true if \c a is not worse than \c b in any objective and better in one
+  static bool Dominates(const Solution& a, const Solution& b);
+
+  /// Split the \c members of \c pool into non-dominated fronts; set the \c rank of each one
+  static std::vector<std::vector<size_t>> SortNonDominated(const std::vector<Solution>& pool,
+                                                           const std::vector<size_t>& members,
+                                                           std::vector<size_t>& rank);
+
+  /// Set the crowding \c distance of the \c front members of \c pool
+  static void ComputeCrowdingDistance(const std::vector<Solution>& pool,
+                                      const std::vector<size_t>& front,
+                                      std::vector<double>& distance);
+
+  /// Insert \c solution into \c archive_ if no archived solution dominates or equals it
+  void UpdateArchive(const Solution& solution);
+
+  /// Non-dominated solutions found so far
+  std::vector<Solution> archive_;
+};  // end of class Nsga2Algorithm
+
+#endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_NSGA2_ALGORITHM_H_
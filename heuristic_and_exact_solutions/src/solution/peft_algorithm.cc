@@ -0,0 +1,134 @@
+/**
+ * \file src/solution/peft_algorithm.cc
+ * \brief Contains the \c PeftAlgorithm class methods.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This source file contains the methods from the \c PeftAlgorithm class that run the PEFT list
+ * scheduling.
+ */
+
+#include "src/solution/peft_algorithm.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+/**
+ * For each task, from the last to the first one:
+ *
+ *   \f[
+ *      OCT(t, p) = \max_{s \in succ(t)} \min_{w \in M} (OCT(s, w) + w(s, w) + \overline{c_{t,s}})
+ *   \f]
+ *
+ * Where \f$ w(s, w) \f$ is the runtime of \f$ s \f$ at \f$ w \f$ plus the average write time of its
+ * output files and \f$ \overline{c_{t,s}} \f$ is the average read time of the files that
+ * \f$ s \f$ consumes from \f$ t \f$; the communication is free when \f$ w = p \f$. The inner
+ * minimum without communication is computed once per child, so the pass is O(T.V.deg).
+ */
+void PeftAlgorithm::ComputeOptimisticCostTable() {
+  const size_t vm_size = GetVirtualMachineSize();
+  std::vector<double> child_cost(vm_size);
+
+  optimistic_cost_table_.assign(GetTaskSize() * vm_size, 0.0);
+  optimistic_rank_.assign(GetTaskSize(), 0.0);
+
+  for (auto it = topological_order_.rbegin(); it != topological_order_.rend(); ++it) {
+    size_t task_id = *it;
+
+    for (size_t child_id : successors_[task_id]) {
+      Task* child = tasks_[child_id];
+      double write_time = 0.0;
+
+      for (File* file : child->get_output_files()) {
+        write_time += GetAverageFileTransferTime(file->get_id());
+      }
+
+      double best_child_cost = std::numeric_limits<double>::max();
+
+      for (size_t w = 0ul; w < vm_size; ++w) {
+        child_cost[w] = OptimisticCost(child_id, w)
+                      + child->get_time() * virtual_machines_[w]->get_slowdown()
+                      + write_time;
+        best_child_cost = std::min(best_child_cost, child_cost[w]);
+      }
+
+      double communication_time = ComputeAverageCommunicationTime(task_id, child_id);
+
+      for (size_t p = 0ul; p < vm_size; ++p) {
+        double cost = std::min(child_cost[p], best_child_cost + communication_time);
+
+        OptimisticCost(task_id, p) = std::max(OptimisticCost(task_id, p), cost);
+      }
+    }
+
+    for (size_t p = 0ul; p < vm_size; ++p) {
+      optimistic_rank_[task_id] += OptimisticCost(task_id, p);
+    }
+
+    optimistic_rank_[task_id] /= static_cast<double>(vm_size);
+
+    DLOG(INFO) << "Optimistic rank of the Task[" << task_id << "]: " << optimistic_rank_[task_id];
+  }
+}  // void PeftAlgorithm::ComputeOptimisticCostTable() {
+
+/**
+ * This method executes the algorithm
+ */
+void PeftAlgorithm::Run() {
+  DLOG(INFO) << "Executing PEFT algorithm...";
+
+  ComputeOptimisticCostTable();
+
+  // Order by height and, inside the same height, by decreasing optimistic rank; see HeftAlgorithm
+  std::vector<Task*> task_list(tasks_);
+
+  std::sort(task_list.begin(), task_list.end(), [&](const Task* a, const Task* b) {
+    if (height_[a->get_id()] != height_[b->get_id()]) {
+      return height_[a->get_id()] < height_[b->get_id()];
+    }
+    return optimistic_rank_[a->get_id()] > optimistic_rank_[b->get_id()];
+  });
+
+  // The OCT is a time; it is weighted and normalised as the makespan in the objective function
+  const double time_weight = get_alpha_time() / get_makespan_max();
+  std::vector<double> bias(optimistic_cost_table_.size());
+
+  for (size_t i = 0ul; i < bias.size(); ++i) {
+    bias[i] = time_weight * optimistic_cost_table_[i];
+  }
+
+  Solution solution(this);
+
+  AllocateStaticFiles(solution);
+
+  DLOG(INFO) << "Doing scheduling";
+  for (Task* task : task_list) {
+    ScheduleTaskAtBestVirtualMachine(task, solution,
+                                     &bias[task->get_id() * GetVirtualMachineSize()]);
+  }
+
+  DLOG(INFO) << "Scheduling done";
+
+  solution.ObjectiveFunction(false, false);
+
+  ReportIncumbent(solution);
+
+  LOG(INFO) << solution;
+  std::cout << solution;
+
+  double time_s = GetElapsedTime();
+
+  std::cerr << solution.get_makespan()
+      << " " << solution.get_cost()
+      << " " << solution.get_security_exposure() / get_maximum_security_and_privacy_exposure()
+      << " " << solution.get_objective_value() << std::endl
+      << time_s << std::endl;
+
+  DLOG(INFO) << "... ending PEFT algorithm";
+}  // end of PeftAlgorithm::Run() method
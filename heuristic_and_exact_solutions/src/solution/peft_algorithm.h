@@ -0,0 +1,55 @@
+/**
+ * \file src/solution/peft_algorithm.h
+ * \brief Contains the \c PeftAlgorithm class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This header file contains the \c PeftAlgorithm class that schedules the tasks following the
+ * Predict Earliest Finish Time (PEFT) list scheduling.
+ */
+
+#ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_PEFT_ALGORITHM_H_
+#define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_PEFT_ALGORITHM_H_
+
+#include <vector>
+#include "src/solution/algorithm.h"
+
+/**
+ * \class PeftAlgorithm peft_algorithm.h "src/solution/peft_algorithm.h"
+ * \brief Schedules the tasks with a lookahead given by the Optimistic Cost Table (OCT)
+ *
+ * \c OCT(t, p) is the shortest time from the end of the task \c t, executed at the Virtual Machine
+ * \c p, to the end of the workflow, when every descendant is executed at its best Virtual Machine.
+ * The table is computed once, so biasing a probe by it costs nothing.
+ */
+class PeftAlgorithm : public Algorithm {
+ public:
+  /// Default constructor
+  PeftAlgorithm() = default;
+
+  /// Default destructor
+  ~PeftAlgorithm() = default;
+
+  /// Compute the Optimistic Cost Table; one backward pass over \c successors_
+  void ComputeOptimisticCostTable();
+
+  /// Create variables; compute the OCT; schedule tasks in rank order; print solution
+  void Run(void);
+
+ private:
+  /// Return the entry of the Optimistic Cost Table of \c task_id at the VM \c vm_id
+  double& OptimisticCost(size_t task_id, size_t vm_id) {
+    return optimistic_cost_table_[task_id * GetVirtualMachineSize() + vm_id];
+  }
+
+  /// Optimistic Cost Table; T x V entries stored row by row
+  std::vector<double> optimistic_cost_table_;
+
+  /// Average of each row of the Optimistic Cost Table; the priority of the tasks
+  std::vector<double> optimistic_rank_;
+};  // end of class PeftAlgorithm
+
+#endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_PEFT_ALGORITHM_H_
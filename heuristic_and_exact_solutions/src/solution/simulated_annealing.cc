@@ -0,0 +1,238 @@
+/**
+ * \file src/solution/simulated_annealing.cc
+ * \brief Contains the \c SimulatedAnnealing class methods.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This source file contains the methods from the \c SimulatedAnnealing class that run the
+ * Simulated Annealing.
+ */
+
+#include "src/solution/simulated_annealing.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+DECLARE_string(sa_cooling);
+DECLARE_double(sa_cooling_rate);
+DECLARE_double(sa_initial_acceptance);
+DECLARE_uint64(sa_moves_per_temperature);
+DECLARE_uint64(sa_max_moves);
+
+/**
+ * A task move and a file move are drawn with the same probability. A file move draws one storage
+ * and fails, without touching the \c solution, if the file does not fit there (see
+ * \c Solution::CanMoveFile()). The makespan and the cost before the move are kept for
+ * \c UndoMove().
+ *
+ * \param[in]  solution  The solution prepared for the incremental moves
+ * \retval     moved     True if a move was applied
+ */
+bool SimulatedAnnealing::ApplyRandomMove(Solution& solution) {
+  last_makespan_ = solution.get_makespan();
+  last_cost_ = solution.get_cost();
+
+  if (rand() % 2 == 0 || dynamic_file_size_ == 0ul) {
+    if (GetVirtualMachineSize() < 2ul) {
+      return false;
+    }
+
+    // Any task but the source and the target ones
+    size_t task_id = 1ul + static_cast<size_t>(rand()) % (GetTaskSize() - 2ul);
+    size_t vm_id = static_cast<size_t>(rand()) % (GetVirtualMachineSize() - 1ul);
+
+    last_move_is_task_ = true;
+    last_move_id_ = task_id;
+    last_move_origin_ = solution.GetTaskAllocation(task_id);
+
+    if (vm_id >= last_move_origin_) {
+      ++vm_id;  // Skip the current VM
+    }
+
+    solution.MoveTaskIncrementally(task_id, vm_id);
+  } else {
+    size_t file_id = static_file_size_ + static_cast<size_t>(rand()) % dynamic_file_size_;
+    size_t storage_id = static_cast<size_t>(rand()) % GetStorageSize();
+
+    last_move_is_task_ = false;
+    last_move_id_ = file_id;
+    last_move_origin_ = solution.GetFileAllocation(file_id);
+
+    // A dynamic file without a producer is never stored
+    if (last_move_origin_ == std::numeric_limits<size_t>::max() || storage_id == last_move_origin_
+        || !solution.CanMoveFile(file_id, storage_id)) {
+      return false;
+    }
+
+    solution.MoveFileIncrementally(file_id, storage_id);
+  }
+
+  return true;
+}  // bool SimulatedAnnealing::ApplyRandomMove(Solution& solution)
+
+/**
+ * The reverse move recomputes the finish times; the makespan and the cost, which it changes by
+ * floating-point deltas, are restored to their values before the move, so the rejected moves leave
+ * no drift behind (see \c Solution::RestoreEvaluation()).
+ *
+ * \param[in]  solution  The solution changed by the last \c ApplyRandomMove()
+ */
+void SimulatedAnnealing::UndoMove(Solution& solution) {
+  if (last_move_is_task_) {
+    solution.MoveTaskIncrementally(last_move_id_, last_move_origin_);
+  } else {
+    solution.MoveFileIncrementally(last_move_id_, last_move_origin_);
+  }
+
+  solution.RestoreEvaluation(last_makespan_, last_cost_);
+}  // void SimulatedAnnealing::UndoMove(Solution& solution)
+
+/**
+ * Sample \c --sa_moves_per_temperature random moves, each one undone, and solve
+ * \f$ e^{-\overline{\Delta} / T_0} = p_0 \f$ for the average worsening \f$ \overline{\Delta} \f$
+ * and \f$ p_0 \f$ = \c --sa_initial_acceptance.
+ *
+ * \param[in]  solution     The solution prepared for the incremental moves
+ * \retval     temperature  The initial temperature
+ */
+double SimulatedAnnealing::ComputeInitialTemperature(Solution& solution) {
+  double objective_value = solution.get_objective_value();
+  double worsening = 0.0;
+  size_t number_of_worsenings = 0ul;
+
+  for (size_t i = 0ul; i < FLAGS_sa_moves_per_temperature; ++i) {
+    if (ApplyRandomMove(solution)) {
+      double delta = solution.get_objective_value() - objective_value;
+
+      if (delta > 0.0) {
+        worsening += delta;
+        ++number_of_worsenings;
+      }
+
+      UndoMove(solution);
+    }
+  }
+
+  if (number_of_worsenings == 0ul) {
+    return 1e-3 * objective_value;
+  }
+
+  return -(worsening / static_cast<double>(number_of_worsenings))
+      / std::log(FLAGS_sa_initial_acceptance);
+}  // double SimulatedAnnealing::ComputeInitialTemperature(Solution& solution)
+
+/**
+ * A worsening \f$ \Delta \f$ is accepted with probability \f$ e^{-\Delta / T} \f$. The geometric
+ * cooling multiplies the temperature by \c --sa_cooling_rate at each level. The adaptive cooling
+ * steers the acceptance ratio of a level toward a target that falls linearly, with the number of
+ * moves, from \c --sa_initial_acceptance to zero: the temperature is multiplied by the rate when
+ * the ratio is above the target and divided by it otherwise.
+ */
+void SimulatedAnnealing::Run() {
+  DLOG(INFO) << "Executing Simulated Annealing...";
+
+  if (FLAGS_sa_cooling != "geometric" && FLAGS_sa_cooling != "adaptive") {
+    LOG(FATAL) << "Invalid cooling schedule: " << FLAGS_sa_cooling;
+  }
+
+  if (FLAGS_sa_cooling_rate <= 0.0 || FLAGS_sa_cooling_rate >= 1.0) {
+    LOG(FATAL) << "The cooling rate must be in (0, 1): " << FLAGS_sa_cooling_rate;
+  }
+
+  if (FLAGS_sa_initial_acceptance <= 0.0 || FLAGS_sa_initial_acceptance >= 1.0) {
+    LOG(FATAL) << "The initial acceptance must be in (0, 1): " << FLAGS_sa_initial_acceptance;
+  }
+
+  if (FLAGS_sa_moves_per_temperature == 0ul) {
+    LOG(FATAL) << "The number of moves per temperature must be positive";
+  }
+
+  Solution solution(this);
+
+  ConstructInitialSolution(solution);
+  solution.PrepareIncrementalEvaluation();
+
+  Solution best_solution = solution;
+  double temperature = ComputeInitialTemperature(solution);
+  double start_time = GetElapsedTime();
+  size_t number_of_moves = 0ul;
+  size_t number_of_accepted_moves = 0ul;
+  size_t number_of_improvements = 0ul;
+
+  ReportIncumbent(best_solution);
+
+  while (number_of_moves < FLAGS_sa_max_moves && !IsTimeLimitReached()) {
+    size_t accepted_moves = 0ul;
+    size_t level_moves = 0ul;
+    bool improved = false;
+
+    for (size_t i = 0ul; i < FLAGS_sa_moves_per_temperature
+        && number_of_moves < FLAGS_sa_max_moves; ++i) {
+      double objective_value = solution.get_objective_value();
+
+      if (!ApplyRandomMove(solution)) {
+        continue;
+      }
+
+      ++number_of_moves;
+      ++level_moves;
+
+      double delta = solution.get_objective_value() - objective_value;
+
+      if (delta <= 0.0
+          || static_cast<double>(rand()) / RAND_MAX < std::exp(-delta / temperature)) {
+        ++accepted_moves;
+
+        if (solution.get_objective_value() < best_solution.get_objective_value()) {
+          best_solution = solution;
+          improved = true;
+          ++number_of_improvements;
+        }
+      } else {
+        UndoMove(solution);
+      }
+    }
+
+    if (improved) {
+      ReportIncumbent(best_solution);
+    }
+
+    number_of_accepted_moves += accepted_moves;
+
+    if (FLAGS_sa_cooling == "geometric") {
+      temperature *= FLAGS_sa_cooling_rate;
+    } else if (level_moves > 0ul) {
+      double progress = static_cast<double>(number_of_moves)
+          / static_cast<double>(FLAGS_sa_max_moves);
+      double acceptance = static_cast<double>(accepted_moves) / static_cast<double>(level_moves);
+
+      if (acceptance > FLAGS_sa_initial_acceptance * (1.0 - progress)) {
+        temperature *= FLAGS_sa_cooling_rate;
+      } else {
+        temperature /= FLAGS_sa_cooling_rate;
+      }
+    }
+  }
+
+  double annealing_time = GetElapsedTime() - start_time;
+
+  // The annealing summed the deltas of its moves; report the values of a full replay instead
+  best_solution.ObjectiveFunction(false, false);
+
+  ReportSolution(best_solution);
+  std::cout << "Simulated annealing: " << number_of_moves << " moves in " << annealing_time
+      << " seconds (" << (annealing_time > 0.0 ? static_cast<double>(number_of_moves)
+                                                     / annealing_time : 0.0)
+      << " moves per second), " << number_of_accepted_moves << " accepted, "
+      << number_of_improvements << " improved the best solution" << std::endl;
+
+  DLOG(INFO) << "... ending Simulated Annealing";
+}  // end of SimulatedAnnealing::Run() method
@@ -0,0 +1,67 @@
+/**
+ * \file src/solution/simulated_annealing.h
+ * \brief Contains the \c SimulatedAnnealing class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This header file contains the \c SimulatedAnnealing class that improves a constructed solution
+ * with random task and file moves.
+ */
+
+#ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_SIMULATED_ANNEALING_H_
+#define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_SIMULATED_ANNEALING_H_
+
+#include "src/solution/algorithm.h"
+
+/**
+ * \class SimulatedAnnealing simulated_annealing.h "src/solution/simulated_annealing.h"
+ * \brief Simulated Annealing over the task and file allocations
+ *
+ * Starts from the HEFT solution (see \c Algorithm::ConstructInitialSolution()). Each move reassigns
+ * a random task to a random VM, or relocates a random dynamic file to a random feasible storage,
+ * and is evaluated incrementally (see \c Solution::MoveTaskIncrementally() and
+ * \c Solution::MoveFileIncrementally()), so large workflows afford millions of moves. The
+ * temperature is updated every \c --sa_moves_per_temperature moves, geometrically or adaptively
+ * (see \c --sa_cooling). The search stops after \c --sa_max_moves moves or at the time limit.
+ */
+class SimulatedAnnealing : public Algorithm {
+ public:
+  /// Default constructor
+  SimulatedAnnealing() = default;
+
+  /// Default destructor
+  ~SimulatedAnnealing() = default;
+
+  /// Construct the initial solution; anneal it; print the best solution and the move rate
+  void Run(void);
+
+ private:
+  /// Apply a random move to \c solution; return false if no feasible move was drawn
+  bool ApplyRandomMove(Solution& solution);
+
+  /// Undo the last move applied by \c ApplyRandomMove(); restore the makespan and cost before it
+  void UndoMove(Solution& solution);
+
+  /// Estimate the temperature that accepts a worsening move with \c --sa_initial_acceptance
+  double ComputeInitialTemperature(Solution& solution);
+
+  /// Whether the last move was a task move, instead of a file move
+  bool last_move_is_task_ = true;
+
+  /// The task or the file of the last move
+  size_t last_move_id_ = 0ul;
+
+  /// The VM or the storage of the task or the file before the last move
+  size_t last_move_origin_ = 0ul;
+
+  /// The makespan of the solution before the last move
+  double last_makespan_ = 0.0;
+
+  /// The cost of the solution before the last move
+  double last_cost_ = 0.0;
+};  // end of class SimulatedAnnealing
+
+#endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_SIMULATED_ANNEALING_H_
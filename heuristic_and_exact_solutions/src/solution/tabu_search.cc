@@ -0,0 +1,233 @@
+/**
+ * \file src/solution/tabu_search.cc
+ * \brief Contains the \c TabuSearch class methods.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This source file contains the methods from the \c TabuSearch class that run the Tabu Search.
+ */
+
+#include "src/solution/tabu_search.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+#include <vector>
+
+DECLARE_uint64(number_of_iteration);
+DECLARE_uint64(number_of_threads);
+DECLARE_uint64(tabu_tenure);
+DECLARE_uint64(tabu_candidate_list_size);
+DECLARE_uint64(tabu_table_size);
+
+/**
+ * A multiplicative hash of the three fields; the table size is a power of two.
+ *
+ * \param[in]  is_task   Whether the attribute is of a task or of a file
+ * \param[in]  id        The task or the file
+ * \param[in]  location  The VM or the storage left by the task or the file
+ * \retval     slot      The slot of the attribute
+ */
+size_t TabuSearch::HashAttribute(bool is_task, size_t id, size_t location) const {
+  size_t hash = (id * 2ul + (is_task ? 1ul : 0ul)) * 0x9E3779B97F4A7C15ul;
+
+  hash ^= (location + 0x632BE59BD9B4E019ul + (hash << 6) + (hash >> 2)) * 0xBF58476D1CE4E5B9ul;
+  hash ^= hash >> 31;
+
+  return hash & (tabu_table_.size() - 1ul);
+}  // size_t TabuSearch::HashAttribute(bool is_task, size_t id, size_t location) const
+
+/**
+ * \param[in]  move       The candidate move
+ * \param[in]  iteration  The current iteration
+ * \retval     tabu       True if the attribute of the \c move has not expired
+ */
+bool TabuSearch::IsTabu(const Move& move, size_t iteration) const {
+  return tabu_table_[HashAttribute(move.is_task, move.id, move.destination)] > iteration;
+}  // bool TabuSearch::IsTabu(const Move& move, size_t iteration) const
+
+/**
+ * A task move and a file move are drawn with the same probability. A drawn file move that does not
+ * fit (see \c Solution::CanMoveFile()) is discarded, so fewer than \c size moves may be returned.
+ *
+ * \param[in]  solution  The current solution
+ * \param[in]  size      The number of draws
+ * \retval     moves     The feasible drawn moves
+ */
+std::vector<TabuSearch::Move> TabuSearch::SampleMoves(const Solution& solution,
+                                                      size_t size) const {
+  std::vector<Move> moves;
+
+  moves.reserve(size);
+
+  for (size_t i = 0ul; i < size; ++i) {
+    if (rand() % 2 == 0 || dynamic_file_size_ == 0ul) {
+      if (GetVirtualMachineSize() < 2ul) {
+        continue;
+      }
+
+      // Any task but the source and the target ones
+      size_t task_id = 1ul + static_cast<size_t>(rand()) % (GetTaskSize() - 2ul);
+      size_t vm_id = static_cast<size_t>(rand()) % (GetVirtualMachineSize() - 1ul);
+
+      if (vm_id >= solution.GetTaskAllocation(task_id)) {
+        ++vm_id;  // Skip the current VM
+      }
+
+      moves.push_back({true, task_id, vm_id});
+    } else {
+      size_t file_id = static_file_size_ + static_cast<size_t>(rand()) % dynamic_file_size_;
+      size_t storage_id = static_cast<size_t>(rand()) % GetStorageSize();
+      size_t current_storage_id = solution.GetFileAllocation(file_id);
+
+      // A dynamic file without a producer is never stored
+      if (current_storage_id != std::numeric_limits<size_t>::max()
+          && storage_id != current_storage_id && solution.CanMoveFile(file_id, storage_id)) {
+        moves.push_back({false, file_id, storage_id});
+      }
+    }
+  }
+
+  return moves;
+}  // std::vector<TabuSearch::Move> TabuSearch::SampleMoves(...) const
+
+/**
+ * \param[in]  solution         The solution prepared for the incremental moves
+ * \param[in]  move             The move
+ * \retval     objective_value  The objective value after the \c move
+ */
+double TabuSearch::ApplyMove(Solution& solution, const Move& move) {
+  return move.is_task ? solution.MoveTaskIncrementally(move.id, move.destination)
+                      : solution.MoveFileIncrementally(move.id, move.destination);
+}  // double TabuSearch::ApplyMove(Solution& solution, const Move& move)
+
+/**
+ * Each thread evaluates a share of the candidate list on its own copy of the current solution,
+ * applying and reverting each move; the makespan and the cost before the move are restored after
+ * the reverse one (see \c Solution::RestoreEvaluation()), so an evaluation leaves no drift. The
+ * chosen move is then applied to every copy, so the copies stay identical.
+ */
+void TabuSearch::Run() {
+  DLOG(INFO) << "Executing Tabu Search...";
+
+  const size_t number_of_threads = std::max<size_t>(FLAGS_number_of_threads, 1ul);
+
+  if (FLAGS_tabu_table_size == 0ul || (FLAGS_tabu_table_size & (FLAGS_tabu_table_size - 1ul))) {
+    LOG(FATAL) << "The tabu table size must be a power of two: " << FLAGS_tabu_table_size;
+  }
+
+  if (FLAGS_tabu_candidate_list_size == 0ul) {
+    LOG(FATAL) << "The candidate list size must be positive";
+  }
+
+  tabu_table_.assign(FLAGS_tabu_table_size, 0ul);
+
+  Solution solution(this);
+
+  ConstructInitialSolution(solution);
+  solution.PrepareIncrementalEvaluation();
+
+  Solution best_solution = solution;
+  std::vector<Solution> copies(number_of_threads - 1ul, solution);
+  size_t number_of_evaluations = 0ul;
+  size_t number_of_aspirations = 0ul;
+  double start_time = GetElapsedTime();
+
+  ReportIncumbent(best_solution);
+
+  size_t iteration = 0ul;
+
+  for (; iteration < FLAGS_number_of_iteration && !IsTimeLimitReached(); ++iteration) {
+    std::vector<Move> moves = SampleMoves(solution, FLAGS_tabu_candidate_list_size);
+    std::vector<double> values(moves.size(), std::numeric_limits<double>::max());
+    std::vector<std::thread> threads;
+    size_t thread_size = std::min(number_of_threads, std::max<size_t>(moves.size(), 1ul));
+
+    auto evaluate = [&](size_t first) {
+      Solution& copy = first == 0ul ? solution : copies[first - 1ul];
+
+      for (size_t i = first; i < moves.size(); i += thread_size) {
+        const Move& move = moves[i];
+        size_t origin = move.is_task ? copy.GetTaskAllocation(move.id)
+                                     : copy.GetFileAllocation(move.id);
+        double makespan = copy.get_makespan();
+        double cost = copy.get_cost();
+
+        values[i] = ApplyMove(copy, move);
+        ApplyMove(copy, {move.is_task, move.id, origin});
+        copy.RestoreEvaluation(makespan, cost);
+      }
+    };
+
+    for (size_t t = 1ul; t < thread_size; ++t) {
+      threads.emplace_back(evaluate, t);
+    }
+
+    evaluate(0ul);
+
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    number_of_evaluations += moves.size();
+
+    // The best admissible move; a tabu move is admissible if it beats the best solution
+    size_t chosen = moves.size();
+    bool aspiration = false;
+
+    for (size_t i = 0ul; i < moves.size(); ++i) {
+      bool tabu = IsTabu(moves[i], iteration);
+
+      if ((!tabu || values[i] < best_solution.get_objective_value())
+          && (chosen == moves.size() || values[i] < values[chosen])) {
+        chosen = i;
+        aspiration = tabu;
+      }
+    }
+
+    if (chosen == moves.size()) {
+      continue;  // Every sampled move is tabu
+    }
+
+    const Move& move = moves[chosen];
+    size_t origin = move.is_task ? solution.GetTaskAllocation(move.id)
+                                 : solution.GetFileAllocation(move.id);
+
+    tabu_table_[HashAttribute(move.is_task, move.id, origin)] = iteration + 1ul
+        + FLAGS_tabu_tenure;
+
+    ApplyMove(solution, move);
+
+    for (Solution& copy : copies) {
+      ApplyMove(copy, move);
+    }
+
+    if (aspiration) {
+      ++number_of_aspirations;
+    }
+
+    if (solution.get_objective_value() < best_solution.get_objective_value()) {
+      best_solution = solution;
+      ReportIncumbent(best_solution);
+    }
+  }
+
+  double search_time = GetElapsedTime() - start_time;
+
+  // The values of the walk were propagated move after move; compute them again for the report
+  best_solution.ObjectiveFunction(false, false);
+
+  ReportSolution(best_solution);
+  std::cout << "Tabu search: " << iteration << " iterations, " << number_of_evaluations
+      << " evaluated moves in " << search_time << " seconds, " << number_of_aspirations
+      << " tabu moves applied by aspiration" << std::endl;
+
+  DLOG(INFO) << "... ending Tabu Search";
+}  // end of TabuSearch::Run() method
@@ -0,0 +1,67 @@
+/**
+ * \file src/solution/tabu_search.h
+ * \brief Contains the \c TabuSearch class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo_prado@id.uff.br\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2020
+ *
+ * This header file contains the \c TabuSearch class that improves a constructed solution with a
+ * short-term memory of the reverted moves.
+ */
+
+#ifndef APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_TABU_SEARCH_H_
+#define APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_TABU_SEARCH_H_
+
+#include <vector>
+
+#include "src/solution/algorithm.h"
+
+/**
+ * \class TabuSearch tabu_search.h "src/solution/tabu_search.h"
+ * \brief Tabu Search over the task and file allocations
+ *
+ * Starts from the HEFT solution (see \c Algorithm::ConstructInitialSolution()). Each iteration
+ * samples \c --tabu_candidate_list_size random task and file moves, evaluates them incrementally
+ * over \c --number_of_threads threads and applies the best admissible one, even if it worsens the
+ * solution. Moving a task, or a file, out of a VM, or a storage, makes its return tabu for
+ * \c --tabu_tenure iterations; a tabu move is admissible only if it gives a new best solution. The
+ * search stops after \c --number_of_iteration iterations or at the time limit.
+ */
+class TabuSearch : public Algorithm {
+ public:
+  /// Default constructor
+  TabuSearch() = default;
+
+  /// Default destructor
+  ~TabuSearch() = default;
+
+  /// Construct the initial solution; iterate the tabu moves; print the best solution
+  void Run(void);
+
+ private:
+  /// A task move, or a file move, to the VM, or the storage, \c destination
+  struct Move {
+    bool is_task;
+    size_t id;
+    size_t destination;
+  };
+
+  /// Return the slot of the attribute (\c is_task, \c id, \c location) in \c tabu_table_
+  size_t HashAttribute(bool is_task, size_t id, size_t location) const;
+
+  /// Return true if the \c move returns a task or a file to a location it left recently
+  bool IsTabu(const Move& move, size_t iteration) const;
+
+  /// Draw up to \c size feasible random moves of \c solution
+  std::vector<Move> SampleMoves(const Solution& solution, size_t size) const;
+
+  /// Apply the \c move incrementally; return the new objective value
+  static double ApplyMove(Solution& solution, const Move& move);
+
+  /// Iteration until which each hashed attribute is tabu; collisions only make the memory stricter
+  std::vector<size_t> tabu_table_;
+};  // end of class TabuSearch
+
+#endif  // APPROXIMATIVE_SOLUTIONS_SRC_SOLUTION_TABU_SEARCH_H_